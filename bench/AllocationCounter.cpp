@@ -0,0 +1,35 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+// the global operator new of the benchmark program, counting every allocation so a benchmark can show
+// that a path does not allocate, new[] and the nothrow forms go through this one by default
+
+static atomic<size_t> allocations(0);
+
+size_t allocationCount()
+{
+	return allocations.load(memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, memory_order_relaxed);
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) {
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
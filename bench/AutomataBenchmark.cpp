@@ -0,0 +1,33 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include "FiniteAutomata.h"
+using namespace std;
+
+// FA::checkIfConsistent per token, on the tokens each automaton is meant for and on ones it has to reject
+
+static void benchAutomaton(const FA& automaton, const string& name, const vector<string>& tokens, const string& input, BenchmarkReport& report)
+{
+	size_t accepted = 0;
+	double seconds = bestSeconds([&]() {
+		accepted = 0;
+		for (const string& token : tokens) {
+			accepted += automaton.checkIfConsistent(token);
+		}
+	});
+	report.add("automaton." + name, input, "time", seconds * 1e9 / tokens.size(), "ns/token");
+	report.add("automaton." + name, input, "accepted", static_cast<double>(accepted) / tokens.size(), "fraction");
+}
+
+void benchAutomata(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	size_t count = static_cast<size_t>(1000000 * options.scale);
+	vector<string> identifiers = generateKeys(count, KeyKind::Identifiers, 2);
+	vector<string> constants = generateKeys(count, KeyKind::Constants, 3);
+
+	FA identifier("FA-identifier.in");
+	FA integer("FA-integer.in");
+	benchAutomaton(identifier, "identifier", identifiers, keyKindName(KeyKind::Identifiers), report);
+	benchAutomaton(identifier, "identifier", constants, keyKindName(KeyKind::Constants), report);
+	benchAutomaton(integer, "integer", constants, keyKindName(KeyKind::Constants), report);
+	benchAutomaton(integer, "integer", identifiers, keyKindName(KeyKind::Identifiers), report);
+}
@@ -0,0 +1,28 @@
+#include "Benchmark.h"
+#include <iomanip>
+#include <sstream>
+using namespace std;
+
+static string quoted(const string& text)
+{
+	string result = "\"";
+	for (char character : text) {
+		if (character == '"' || character == '\\')
+			result += '\\';
+		result += character;
+	}
+	return result + "\"";
+}
+
+void BenchmarkReport::add(const string& benchmark, const string& input, const string& metric, double value, const string& unit)
+{
+	out << "{\"benchmark\": " << quoted(benchmark) << ", \"input\": " << quoted(input) << ", \"metric\": " << quoted(metric)
+		<< ", \"value\": " << setprecision(6) << value << ", \"unit\": " << quoted(unit) << "}" << endl;
+}
+
+string megabytes(size_t bytes)
+{
+	ostringstream text;
+	text << setprecision(3) << bytes / (1024.0 * 1024.0) << " MB";
+	return text.str();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <ostream>
+#include <chrono>
+#include <algorithm>
+
+// what every benchmark case gets from the command line
+struct BenchmarkOptions {
+    // multiplies the size of every generated input
+    double scale = 1;
+    // a program to measure besides the generated ones, empty if none was given
+    std::string programPath;
+};
+
+// results are written one JSON object per line, so two runs can be compared with any script:
+// {"benchmark": "scanner.scan", "input": "generated 16 MB", "metric": "throughput", "value": 210.5, "unit": "MB/s"}
+class BenchmarkReport {
+public:
+    explicit BenchmarkReport(std::ostream& out) : out(out) {}
+
+    void add(const std::string& benchmark, const std::string& input, const std::string& metric, double value, const std::string& unit);
+
+private:
+    std::ostream& out;
+};
+
+// seconds the fastest of a few runs took, the others only warm up caches and the allocator
+template <class Run>
+double bestSeconds(Run run, int rounds = 3)
+{
+    double best = 0;
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = round == 0 ? seconds : std::min(best, seconds);
+    }
+    return best;
+}
+
+std::string megabytes(size_t bytes);
+// heap allocations the whole program made so far, counted by its operator new
+size_t allocationCount();
+
+void benchClassifier(const BenchmarkOptions& options, BenchmarkReport& report);
+void benchScanner(const BenchmarkOptions& options, BenchmarkReport& report);
+void benchAutomata(const BenchmarkOptions& options, BenchmarkReport& report);
+void benchHashTable(const BenchmarkOptions& options, BenchmarkReport& report);
+void benchGrammar(const BenchmarkOptions& options, BenchmarkReport& report);
+void benchSymbolTable(const BenchmarkOptions& options, BenchmarkReport& report);
@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// usage:
+//   bench [--only name] [--scale factor] [--program file] [--output file]
+//       runs the benchmarks (or only the named one) and writes a JSON line per result, to stdout by default
+//   bench generate program bytes [seed]
+//   bench generate grammar nonterminals [seed]
+//       writes a generated input to stdout, to run the lab or the parsers on
+// run it from lab4, where token.txt and the FA files are
+
+struct BenchmarkCase {
+	const char* name;
+	void (*run)(const BenchmarkOptions&, BenchmarkReport&);
+};
+
+static const BenchmarkCase CASES[] = {
+	{ "classifier", benchClassifier },
+	{ "scanner", benchScanner },
+	{ "automaton", benchAutomata },
+	{ "hashtable", benchHashTable },
+	{ "symboltable", benchSymbolTable },
+	{ "grammar", benchGrammar },
+};
+
+static int generate(int argc, char** argv)
+{
+	string kind = argc > 2 ? argv[2] : "";
+	unsigned seed = argc > 4 ? static_cast<unsigned>(atoi(argv[4])) : 1;
+	if (argc < 4 || (kind != "program" && kind != "grammar")) {
+		cerr << "bench generate program bytes [seed] | bench generate grammar nonterminals [seed]" << endl;
+		return 1;
+	}
+	if (kind == "program")
+		cout << generateProgram(static_cast<size_t>(atoll(argv[3])), seed);
+	else
+		cout << generateGrammar(atoi(argv[3]), 200, seed);
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && string(argv[1]) == "generate")
+		return generate(argc, argv);
+
+	BenchmarkOptions options;
+	string only;
+	string outputPath;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		string option = argv[i];
+		if (option == "--only")
+			only = argv[i + 1];
+		else if (option == "--scale")
+			options.scale = atof(argv[i + 1]);
+		else if (option == "--program")
+			options.programPath = argv[i + 1];
+		else if (option == "--output")
+			outputPath = argv[i + 1];
+		else {
+			cerr << "unknown option " << option << endl;
+			return 1;
+		}
+	}
+
+	ofstream outputFile;
+	if (!outputPath.empty())
+		outputFile.open(outputPath);
+	BenchmarkReport report(outputPath.empty() ? cout : outputFile);
+
+	for (const BenchmarkCase& benchmark : CASES) {
+		if (!only.empty() && only != benchmark.name)
+			continue;
+		cerr << "running " << benchmark.name << endl;
+		benchmark.run(options, report);
+	}
+	return 0;
+}
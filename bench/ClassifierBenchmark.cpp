@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "ByteClassifier.h"
+#include "LexerSpec.h"
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+using namespace std;
+
+// measures how fast each kernel of the byte classifier walks a program from delimiter to delimiter
+// without a program file a program of long identifiers and tab runs is made up
+
+static string syntheticProgram(size_t size)
+{
+	mt19937 random(13);
+	const string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+	string program;
+	program.reserve(size + 64);
+	while (program.size() < size) {
+		int kind = random() % 10;
+		if (kind < 6) {
+			program += letters[random() % 52];
+			for (int length = 8 + random() % 120; length > 0; length--)
+				program += letters[random() % letters.size()];
+		}
+		else if (kind < 8) {
+			program.append(1 + random() % 64, '\t');
+		}
+		else if (kind < 9) {
+			program += " ~ ";
+		}
+		else {
+			program += "\n";
+		}
+	}
+	return program;
+}
+
+void benchClassifier(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	string program;
+	string input;
+	if (!options.programPath.empty()) {
+		ifstream file(options.programPath, ios::binary);
+		stringstream content;
+		content << file.rdbuf();
+		program = content.str();
+		input = options.programPath;
+	}
+	else {
+		program = syntheticProgram(static_cast<size_t>((32 << 20) * options.scale));
+		input = "long identifiers " + megabytes(program.size());
+	}
+
+	LexerSpec spec;
+	const int ROUNDS = 10;
+	const char* data = program.data();
+	const char* end = data + program.size();
+
+	double scalarSpeed = 0;
+	for (ByteClassifier::Kernel kernel : { ByteClassifier::Kernel::Scalar, ByteClassifier::Kernel::SSE2,
+		ByteClassifier::Kernel::SSSE3, ByteClassifier::Kernel::AVX2 }) {
+		ByteClassifier delimiters = spec.getDelimiterClassifier();
+		ByteClassifier ignored = spec.getIgnoredClassifier();
+		delimiters.setKernel(kernel);
+		ignored.setKernel(kernel);
+		if (delimiters.getKernel() != kernel) {
+			continue;
+		}
+
+		//the same walk the scanner does: skip ignored runs, jump over every token to the delimiter after it
+		size_t boundaries = 0;
+		double seconds = bestSeconds([&]() {
+			boundaries = 0;
+			for (int round = 0; round < ROUNDS; round++) {
+				for (const char* curr = data; curr < end; boundaries++) {
+					if (ignored.contains(*curr))
+						curr += ignored.findFirstNotIn(curr, end);
+					else if (delimiters.contains(*curr))
+						curr++;
+					else
+						curr += 1 + delimiters.findFirstIn(curr + 1, end);
+				}
+			}
+		});
+		double speed = program.size() * ROUNDS / (1024.0 * 1024.0) / seconds;
+		if (kernel == ByteClassifier::Kernel::Scalar)
+			scalarSpeed = speed;
+
+		string benchmark = string("classifier.") + ByteClassifier::kernelName(kernel);
+		report.add(benchmark, input, "throughput", speed, "MB/s");
+		report.add(benchmark, input, "speedup", speed / scalarSpeed, "x scalar");
+		report.add(benchmark, input, "boundaries", static_cast<double>(boundaries / ROUNDS), "count");
+	}
+}
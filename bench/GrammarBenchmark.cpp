@@ -0,0 +1,39 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include "Grammar.h"
+#include <cstdio>
+#include <fstream>
+using namespace std;
+
+// Grammar::computeFirst and computeFollow on generated grammars of growing size
+// grammars are only read from files, so each one is written out first
+// the sets are bit matrices over all the symbols, so the size grows with its square
+
+void benchGrammar(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	const string path = "bench-grammar.tmp";
+	for (int size : { 1000, 4000, 16000 }) {
+		int nonTerminals = max(1, static_cast<int>(size * options.scale));
+		{
+			ofstream file(path);
+			file << generateGrammar(nonTerminals, 200, 7);
+		}
+		string input = "generated " + to_string(nonTerminals) + " nonterminals";
+
+		Grammar grammar;
+		double readSeconds = bestSeconds([&]() {
+			grammar.readFromFile(path);
+		});
+		double firstSeconds = bestSeconds([&]() {
+			grammar.computeFirst();
+		});
+		double followSeconds = bestSeconds([&]() {
+			grammar.computeFollow();
+		});
+		report.add("grammar.readFromFile", input, "time", readSeconds * 1e3, "ms");
+		report.add("grammar.computeFirst", input, "time", firstSeconds * 1e3, "ms");
+		report.add("grammar.computeFollow", input, "time", followSeconds * 1e3, "ms");
+		report.add("grammar", input, "productions", grammar.productionCount(), "count");
+	}
+	remove(path.c_str());
+}
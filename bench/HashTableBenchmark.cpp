@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include "HashTable.h"
+#include <random>
+using namespace std;
+
+// HashTable inserts and lookups at a few sizes and for each kind of key
+// lookups hit every key equally often or follow a Zipf distribution, the way a few names dominate a program
+
+static vector<size_t> zipfOrder(size_t keyCount, size_t lookups, unsigned seed)
+{
+	vector<double> cumulative(keyCount);
+	double total = 0;
+	for (size_t rank = 0; rank < keyCount; rank++) {
+		total += 1.0 / (rank + 1);
+		cumulative[rank] = total;
+	}
+
+	mt19937 random(seed);
+	uniform_real_distribution<double> uniform(0, total);
+	vector<size_t> order(lookups);
+	for (size_t& index : order) {
+		index = lower_bound(cumulative.begin(), cumulative.end(), uniform(random)) - cumulative.begin();
+		index = min(index, keyCount - 1);
+	}
+	return order;
+}
+
+void benchHashTable(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	for (size_t size : { size_t(1000), size_t(100000), size_t(1000000) }) {
+		size = max<size_t>(1, static_cast<size_t>(size * options.scale));
+		for (KeyKind kind : { KeyKind::Identifiers, KeyKind::Numbered, KeyKind::Constants }) {
+			vector<string> keys = generateKeys(size * 2, kind, 4);
+			vector<string> missing(keys.begin() + size, keys.end());
+			keys.resize(size);
+			string input = string(keyKindName(kind)) + " " + to_string(size);
+
+			//the table starts at the size the scanner gives it, so inserts include every rehash
+			double insertSeconds = bestSeconds([&]() {
+				HashTable table(100);
+				for (const string& key : keys) {
+					table.findOrInsert(key);
+				}
+			});
+			report.add("hashtable.insert", input, "time", insertSeconds * 1e9 / size, "ns/op");
+
+			HashTable table(100);
+			for (const string& key : keys) {
+				table.findOrInsert(key);
+			}
+			size_t lookups = max<size_t>(size, 1000000);
+			mt19937 random(5);
+			vector<size_t> uniformOrder(lookups);
+			for (size_t& index : uniformOrder) {
+				index = random() % size;
+			}
+			vector<size_t> skewedOrder = zipfOrder(size, lookups, 6);
+
+			size_t found = 0;
+			auto lookup = [&](const vector<string>& source, const vector<size_t>& order) {
+				return bestSeconds([&]() {
+					for (size_t index : order) {
+						found += table.searchElem(source[index]) >= 0;
+					}
+				});
+			};
+			report.add("hashtable.lookup", input + " uniform", "time", lookup(keys, uniformOrder) * 1e9 / lookups, "ns/op");
+			report.add("hashtable.lookup", input + " zipf", "time", lookup(keys, skewedOrder) * 1e9 / lookups, "ns/op");
+			report.add("hashtable.lookup", input + " missing", "time", lookup(missing, uniformOrder) * 1e9 / lookups, "ns/op");
+			report.add("hashtable", input, "load factor", table.loadFactor(), "fraction");
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include "Scanner.h"
+#include <cstdio>
+#include <fstream>
+using namespace std;
+
+// Scanner::scan, scanParallel and scanPipelined on generated programs and on the program given on the command line,
+// and how often the token path allocates
+// the scanner reads from a file, so generated programs are written next to the FA files first
+
+static void benchProgram(const string& path, const string& input, shared_ptr<const LexerSpec> spec, BenchmarkReport& report)
+{
+	size_t bytes = static_cast<size_t>(ifstream(path, ios::binary | ios::ate).tellg());
+	size_t tokens = 0;
+	double seconds = bestSeconds([&]() {
+		Scanner scanner(path, spec);
+		scanner.scan();
+		tokens = scanner.getPIF().size();
+	});
+	report.add("scanner.scan", input, "throughput", bytes / (1024.0 * 1024.0) / seconds, "MB/s");
+	report.add("scanner.scan", input, "tokens", tokens / seconds, "tokens/s");
+
+	double parallelSeconds = bestSeconds([&]() {
+		Scanner scanner(path, spec);
+		scanner.scanParallel();
+	});
+	report.add("scanner.scanParallel", input, "throughput", bytes / (1024.0 * 1024.0) / parallelSeconds, "MB/s");
+	report.add("scanner.scanParallel", input, "speedup", seconds / parallelSeconds, "x scan");
+
+	//the threads intern into one table instead of merging their own tables afterwards
+	double sharedSeconds = bestSeconds([&]() {
+		Scanner scanner(path, spec, make_shared<ConcurrentSymbolTable>());
+		scanner.scanParallel();
+	});
+	report.add("scanner.scanParallel shared", input, "throughput", bytes / (1024.0 * 1024.0) / sharedSeconds, "MB/s");
+	report.add("scanner.scanParallel shared", input, "speedup", seconds / sharedSeconds, "x scan");
+
+	//writing the files is part of both, so the pipeline is compared with scanning and then writing
+	double writeSeconds = bestSeconds([&]() {
+		Scanner scanner(path, spec);
+		scanner.scan();
+		scanner.generatePIFFile("bench-PIF.tmp");
+		scanner.generateSTFile("bench-STF.tmp");
+	});
+	double pipelinedSeconds = bestSeconds([&]() {
+		Scanner scanner(path, spec);
+		scanner.scanPipelined("bench-PIF.tmp", "bench-STF.tmp");
+	});
+	remove("bench-PIF.tmp");
+	remove("bench-STF.tmp");
+	report.add("scanner.scan+write", input, "throughput", bytes / (1024.0 * 1024.0) / writeSeconds, "MB/s");
+	report.add("scanner.scanPipelined", input, "throughput", bytes / (1024.0 * 1024.0) / pipelinedSeconds, "MB/s");
+	report.add("scanner.scanPipelined", input, "speedup", writeSeconds / pipelinedSeconds, "x scan+write");
+
+	//a second scanner sharing the table of a first one has seen every symbol already,
+	//reading and writing its tokens should not allocate at all past opening the files
+	auto symbols = make_shared<ConcurrentSymbolTable>();
+	Scanner(path, spec, symbols).scan();
+	Scanner seen(path, spec, symbols);
+	Token token;
+	size_t seenTokens = 0;
+	size_t allocations = allocationCount();
+	while (seen.nextToken(token)) {
+		seenTokens++;
+	}
+	report.add("scanner.nextToken seen symbols", input, "allocations", static_cast<double>(allocationCount() - allocations) / seenTokens, "per token");
+
+	Scanner streamed(path, spec, symbols);
+	allocations = allocationCount();
+	streamed.streamPIFFile("bench-PIF.tmp");
+	remove("bench-PIF.tmp");
+	report.add("scanner.streamPIFFile seen symbols", input, "allocations", static_cast<double>(allocationCount() - allocations) / seenTokens, "per token");
+}
+
+void benchScanner(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	shared_ptr<const LexerSpec> spec = make_shared<const LexerSpec>();
+	const string path = "bench-program.tmp";
+	for (size_t size : { size_t(1) << 20, size_t(16) << 20 }) {
+		string program = generateProgram(static_cast<size_t>(size * options.scale), 1);
+		{
+			ofstream file(path, ios::binary);
+			file << program;
+		}
+		benchProgram(path, "generated " + megabytes(program.size()), spec, report);
+	}
+	remove(path.c_str());
+
+	if (!options.programPath.empty()) {
+		benchProgram(options.programPath, options.programPath, spec, report);
+	}
+}
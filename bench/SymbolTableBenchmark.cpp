@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "Workload.h"
+#include "ConcurrentSymbolTable.h"
+#include <random>
+#include <thread>
+using namespace std;
+
+// ConcurrentSymbolTable::findOrInsert from a growing number of threads sharing one table
+// every thread interns its own stream of keys drawn from the same set, so most calls find a symbol
+// that some thread already inserted, the way scanners of files of one project see the same names
+
+void benchSymbolTable(const BenchmarkOptions& options, BenchmarkReport& report)
+{
+	size_t keyCount = max<size_t>(1, static_cast<size_t>(100000 * options.scale));
+	size_t callsPerThread = max<size_t>(keyCount, 1000000);
+	vector<string> keys = generateKeys(keyCount, KeyKind::Identifiers, 8);
+	unsigned maxThreads = max(1u, thread::hardware_concurrency());
+
+	vector<unsigned> threadCounts;
+	for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	double singleSeconds = 0;
+	for (unsigned threads : threadCounts) {
+		vector<vector<size_t>> orders(threads, vector<size_t>(callsPerThread));
+		for (unsigned t = 0; t < threads; t++) {
+			mt19937 random(t + 1);
+			for (size_t& index : orders[t]) {
+				index = random() % keyCount;
+			}
+		}
+
+		int symbols = 0;
+		double seconds = bestSeconds([&]() {
+			ConcurrentSymbolTable table(100);
+			vector<thread> workers;
+			for (unsigned t = 0; t < threads; t++) {
+				workers.emplace_back([&, t]() {
+					for (size_t index : orders[t]) {
+						table.findOrInsert(keys[index]);
+					}
+				});
+			}
+			for (thread& worker : workers) {
+				worker.join();
+			}
+			symbols = table.size();
+		});
+		if (threads == 1) {
+			singleSeconds = seconds;
+		}
+
+		string input = to_string(keyCount) + " identifiers " + to_string(threads) + " threads";
+		double calls = static_cast<double>(callsPerThread) * threads;
+		report.add("symboltable.findOrInsert", input, "throughput", calls / seconds / 1e6, "Mops/s");
+		report.add("symboltable.findOrInsert", input, "scaling", singleSeconds / seconds * threads, "x 1 thread");
+		report.add("symboltable", input, "symbols", symbols, "count");
+	}
+}
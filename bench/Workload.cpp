@@ -0,0 +1,256 @@
+#include "Workload.h"
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+using namespace std;
+
+namespace {
+
+const char* const WORDS[] = { "index", "count", "max", "min", "value", "sum", "number", "total", "flag", "item", "result", "limit" };
+const char* const TYPES[] = { "num", "boolean", "str" };
+const char* const ARITHMETIC[] = { "plus", "minus", "times", "div", "mod" };
+const char* const RELATIONAL[] = { "gt", "gte", "lt", "lte", "eq", "ne" };
+const unordered_set<string> RESERVED = { "plus", "minus", "times", "div", "gt", "gte", "eq", "mod", "lt", "lte", "ne",
+	"num", "boolean", "str", "entry", "for", "until", "if", "else", "stop", "true", "false", "is", "input", "output" };
+
+string randomName(mt19937& random, size_t maxLength)
+{
+	const string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	const string digits = "0123456789";
+	string name;
+	do {
+		name.assign(1, letters[random() % letters.size()]);
+		for (size_t length = random() % maxLength; length > 0; length--) {
+			name += random() % 4 == 0 ? digits[random() % digits.size()] : letters[random() % letters.size()];
+		}
+	} while (RESERVED.count(name) != 0);
+	return name;
+}
+
+template <class T, size_t N>
+const T& pick(mt19937& random, const T(&choices)[N])
+{
+	return choices[random() % N];
+}
+
+// writes statements of g4.txt, blocks are indented with tabs like the sample programs
+class ProgramWriter {
+public:
+	ProgramWriter(string& program, unsigned seed, size_t variableCount) : program(program), random(seed)
+	{
+		for (size_t i = 0; i < variableCount; i++) {
+			variables.push_back(i % 2 == 0 ? string(pick(random, WORDS)) + to_string(i) : randomName(random, 10));
+		}
+	}
+
+	void statement(int depth)
+	{
+		//blank lines between statements, like the samples have
+		if (random() % 14 == 0) {
+			program += "\n";
+		}
+		int kind = random() % 20;
+		if (depth >= 4 && kind >= 13) {
+			kind = random() % 13;
+		}
+		indent(depth);
+		if (kind < 3) {
+			declaration();
+		}
+		else if (kind < 8) {
+			program += variable() + " is " + expression(2) + ":";
+		}
+		else if (kind < 10) {
+			program += "input>>" + variable() + ":";
+		}
+		else if (kind < 12) {
+			program += "output<<" + expression(1) + ":";
+		}
+		else if (kind < 13) {
+			program += "stop:";
+		}
+		else if (kind < 17) {
+			program += "if [" + condition() + "] ";
+			block(depth);
+			if (random() % 2 == 0) {
+				program += "\n";
+				indent(depth);
+				program += "else ";
+				block(depth);
+			}
+		}
+		else if (kind < 19) {
+			program += "until [" + condition() + "]";
+			block(depth);
+		}
+		else {
+			program += "for [" + name() + ", " + expression(0) + ", " + expression(1) + ", " + constant() + "]";
+			block(depth);
+		}
+		program += "\n";
+	}
+
+	void block(int depth)
+	{
+		program += "~\n";
+		for (int count = 1 + random() % 4; count > 0; count--) {
+			statement(depth + 1);
+		}
+		indent(depth);
+		program += "~";
+	}
+
+private:
+	string& program;
+	mt19937 random;
+	vector<string> variables;
+
+	void indent(int depth) { program.append(depth, '\t'); }
+	const string& name() { return variables[random() % variables.size()]; }
+	string constant() { return to_string(random() % (random() % 4 == 0 ? 100000 : 100)); }
+
+	string variable()
+	{
+		if (random() % 8 == 0) {
+			return name() + "[" + expression(0) + "]";
+		}
+		return name();
+	}
+
+	void declaration()
+	{
+		program += pick(random, TYPES);
+		program += " ";
+		for (int count = 1 + random() % 4; count > 0; count--) {
+			int kind = random() % 6;
+			program += name();
+			if (kind == 0) {
+				program += "[" + constant() + "]";
+			}
+			else if (kind == 1) {
+				program += " is " + expression(1);
+			}
+			program += count > 1 ? ", " : ":";
+		}
+	}
+
+	string factor(int depth)
+	{
+		int kind = random() % 10;
+		if (kind < 5) {
+			return variable();
+		}
+		if (kind < 8 || depth == 0) {
+			return constant();
+		}
+		if (kind < 9) {
+			return random() % 2 == 0 ? "true" : "false";
+		}
+		return "(" + expression(depth - 1) + ")";
+	}
+
+	string expression(int depth)
+	{
+		string result = factor(depth);
+		for (int count = random() % 3; count > 0; count--) {
+			result += " " + string(pick(random, ARITHMETIC)) + " " + factor(depth);
+		}
+		return result;
+	}
+
+	string condition()
+	{
+		return expression(1) + " " + pick(random, RELATIONAL) + " " + expression(1);
+	}
+};
+
+}
+
+string generateProgram(size_t bytes, unsigned seed)
+{
+	string program = "entry ~\n";
+	program.reserve(bytes + 4096);
+	//about as many different names as a program of that size would declare
+	ProgramWriter writer(program, seed, max<size_t>(16, bytes / 400));
+	while (program.size() < bytes) {
+		writer.statement(1);
+	}
+	program += "~";
+	return program;
+}
+
+string generateGrammar(int nonTerminals, int terminals, unsigned seed)
+{
+	mt19937 random(seed);
+	string grammar = "# Non-terminals\n";
+	for (int i = 0; i < nonTerminals; i++) {
+		grammar += "N" + to_string(i) + "\n";
+	}
+	grammar += "$\n# Terminals\n";
+	for (int i = 0; i < terminals; i++) {
+		grammar += "t" + to_string(i) + "\n";
+	}
+	grammar += "e\n$\n# Start symbol\nN0\n$\n# Productions\n";
+
+	auto terminal = [&]() { return " t" + to_string(random() % terminals); };
+	auto nonTerminal = [&]() { return " N" + to_string(random() % nonTerminals); };
+	for (int i = 0; i < nonTerminals; i++) {
+		string lhs = "N" + to_string(i) + " ->";
+		grammar += lhs + terminal() + "\n";
+		for (int count = random() % 4; count > 0; count--) {
+			int kind = random() % 20;
+			grammar += lhs;
+			if (kind < 3) {
+				grammar += " e";
+			}
+			else if (kind < 8) {
+				grammar += terminal() + nonTerminal();
+			}
+			else {
+				for (int length = 1 + random() % 5; length > 0; length--) {
+					grammar += random() % 5 < 3 ? nonTerminal() : terminal();
+				}
+			}
+			grammar += "\n";
+		}
+	}
+	return grammar;
+}
+
+const char* keyKindName(KeyKind kind)
+{
+	switch (kind) {
+	case KeyKind::Identifiers:
+		return "identifiers";
+	case KeyKind::Numbered:
+		return "numbered";
+	default:
+		return "constants";
+	}
+}
+
+vector<string> generateKeys(size_t count, KeyKind kind, unsigned seed)
+{
+	mt19937 random(seed);
+	unordered_set<string> seen;
+	vector<string> keys;
+	keys.reserve(count);
+	while (keys.size() < count) {
+		string key;
+		switch (kind) {
+		case KeyKind::Identifiers:
+			key = randomName(random, 12);
+			break;
+		case KeyKind::Numbered:
+			key = "temporaryValue" + to_string(keys.size());
+			break;
+		default:
+			key = to_string(random() % (count * 10));
+			break;
+		}
+		if (seen.insert(key).second) {
+			keys.push_back(key);
+		}
+	}
+	return keys;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// made up inputs shaped like the real ones, the same seed always gives the same input
+
+// a program in the style of p1.txt of about the given size: declarations, input and output, assignments,
+// nested if / until / for blocks, it is lexically correct and parses with g4.txt
+std::string generateProgram(size_t bytes, unsigned seed);
+
+// a grammar in the format Grammar::readFromFile reads, with nonterminals N0.. and terminals t0..
+// every nonterminal has a production of terminals only, the rest mix both and a few are "e"
+std::string generateGrammar(int nonTerminals, int terminals, unsigned seed);
+
+enum class KeyKind {
+    Identifiers,    // short random names, like the identifiers of a program
+    Numbered,       // one name with a counter after it, long common prefixes
+    Constants       // decimal numbers
+};
+
+const char* keyKindName(KeyKind kind);
+// count different keys of the kind
+std::vector<std::string> generateKeys(size_t count, KeyKind kind, unsigned seed);
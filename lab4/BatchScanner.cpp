@@ -0,0 +1,98 @@
+#include "BatchScanner.h"
+#include "Scanner.h"
+#include <algorithm>
+using namespace std;
+
+BatchScanner::BatchScanner(shared_ptr<const LexerSpec> spec, unsigned threadCount)
+	: BatchScanner(spec, nullptr, threadCount)
+{
+}
+
+BatchScanner::BatchScanner(shared_ptr<const LexerSpec> spec, shared_ptr<ConcurrentSymbolTable> symbols, unsigned threadCount)
+	: spec(spec), symbols(symbols), threadCount(threadCount == 0 ? 1 : threadCount)
+{
+}
+
+vector<string> BatchScanner::scanFiles(const vector<string>& paths)
+{
+	//biggest files first, dealt round robin, so the queues start out about even
+	vector<pair<streamoff, size_t>> bySize;
+	for (size_t i = 0; i < paths.size(); i++) {
+		ifstream file(paths[i], ios::binary | ios::ate);
+		bySize.push_back({ file ? static_cast<streamoff>(file.tellg()) : 0, i });
+	}
+	sort(bySize.begin(), bySize.end(), [](const pair<streamoff, size_t>& a, const pair<streamoff, size_t>& b) {
+		return a.first > b.first;
+	});
+
+	unsigned workerCount = static_cast<unsigned>(min<size_t>(threadCount, max<size_t>(paths.size(), 1)));
+	vector<WorkQueue> queues(workerCount);
+	for (size_t i = 0; i < bySize.size(); i++) {
+		queues[i % workerCount].files.push_back(bySize[i].second);
+	}
+
+	vector<string> results(paths.size());
+	vector<thread> workers;
+	for (unsigned self = 0; self < workerCount; self++) {
+		workers.emplace_back([&, self]() {
+			size_t file;
+			while (takeWork(queues, self, file)) {
+				results[file] = scanFile(paths[file]);
+			}
+		});
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	vector<string> errors;
+	for (const string& result : results) {
+		if (!result.empty()) {
+			errors.push_back(result);
+		}
+	}
+	return errors;
+}
+
+bool BatchScanner::takeWork(vector<WorkQueue>& queues, unsigned self, size_t& file)
+{
+	//own queue from the front, biggest files first
+	{
+		lock_guard<mutex> guard(queues[self].lock);
+		if (!queues[self].files.empty()) {
+			file = queues[self].files.front();
+			queues[self].files.pop_front();
+			return true;
+		}
+	}
+
+	//steal from the back of someone else's queue, where the small files are, so the owner rarely meets us
+	//nothing is ever added once scanning started, so one empty round means all work is taken
+	for (size_t i = 1; i < queues.size(); i++) {
+		WorkQueue& victim = queues[(self + i) % queues.size()];
+		lock_guard<mutex> guard(victim.lock);
+		if (!victim.files.empty()) {
+			file = victim.files.back();
+			victim.files.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+string BatchScanner::scanFile(const string& path)
+{
+	try {
+		Scanner scanner(path, spec, symbols);
+		scanner.scan();
+		scanner.generatePIFFile(path + ".PIF.out");
+		if (!symbols) {
+			scanner.generateSTFile(path + ".STF.out");
+		}
+	}
+	catch (const exception& e) {
+		//anything thrown on a worker would end the whole batch, it is only this file that failed
+		return path + ": " + e.what();
+	}
+	return "";
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include "LexerSpec.h"
+#include "ConcurrentSymbolTable.h"
+
+// scans many programs on a pool of threads sharing one LexerSpec
+// every thread has its own queue of files and takes work from the others once its queue is empty,
+// so a few big files don't leave the other threads idle
+class BatchScanner {
+public:
+    explicit BatchScanner(std::shared_ptr<const LexerSpec> spec,
+        unsigned threadCount = std::thread::hardware_concurrency());
+    // all of the files put their symbols in one table, their PIFs refer to its ids and no STF is written per file
+    BatchScanner(std::shared_ptr<const LexerSpec> spec, std::shared_ptr<ConcurrentSymbolTable> symbols,
+        unsigned threadCount = std::thread::hardware_concurrency());
+
+    // writes <file>.PIF.out and <file>.STF.out for every file that is lexically correct
+    // returns the error message of every file that is not or could not be scanned at all, in the order the files were given
+    std::vector<std::string> scanFiles(const std::vector<std::string>& paths);
+
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<size_t> files;
+    };
+
+    std::shared_ptr<const LexerSpec> spec;
+    std::shared_ptr<ConcurrentSymbolTable> symbols;
+    unsigned threadCount;
+
+    bool takeWork(std::vector<WorkQueue>& queues, unsigned self, size_t& file);
+    std::string scanFile(const std::string& path);
+};
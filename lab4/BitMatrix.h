@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// rows of bitsets of the same width kept in one array, the union of two rows is a few word wide ors
+// the grammar keeps a row per symbol for FIRST and FOLLOW, with a bit per symbol id
+class BitMatrix {
+public:
+    BitMatrix() : rowCount(0), wordsPerRow(0) {}
+    BitMatrix(size_t rows, size_t bits) { reset(rows, bits); }
+
+    // all bits cleared
+    void reset(size_t rows, size_t bits) {
+        rowCount = rows;
+        wordsPerRow = (bits + 63) / 64;
+        words.assign(rowCount * wordsPerRow, 0);
+    }
+
+    size_t rows() const { return rowCount; }
+
+    bool test(size_t row, size_t bit) const {
+        return (words[row * wordsPerRow + bit / 64] >> (bit % 64)) & 1;
+    }
+    // true when the bit was not set before
+    bool set(size_t row, size_t bit) {
+        uint64_t& word = words[row * wordsPerRow + bit / 64];
+        uint64_t mask = uint64_t(1) << (bit % 64);
+        bool added = (word & mask) == 0;
+        word |= mask;
+        return added;
+    }
+
+    void clearRow(size_t row) {
+        for (size_t i = 0; i < wordsPerRow; i++) {
+            words[row * wordsPerRow + i] = 0;
+        }
+    }
+
+    // ors the source row into the target row, except is a bit that is not copied over (-1 copies all of them)
+    // true when the target row changed
+    bool unite(size_t target, size_t source, long long except = -1) {
+        return unite(target, *this, source, except);
+    }
+    // the same with the source row taken from another matrix of the same width
+    bool unite(size_t target, const BitMatrix& other, size_t source, long long except = -1) {
+        uint64_t* to = &words[target * wordsPerRow];
+        const uint64_t* from = &other.words[source * wordsPerRow];
+        bool changed = false;
+        for (size_t i = 0; i < wordsPerRow; i++) {
+            uint64_t added = from[i] & ~to[i];
+            if (except >= 0 && static_cast<size_t>(except) / 64 == i) {
+                added &= ~(uint64_t(1) << (except % 64));
+            }
+            if (added != 0) {
+                to[i] |= added;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    // calls f with every set bit of the row, in increasing order
+    template <class F>
+    void forEach(size_t row, F f) const {
+        const uint64_t* from = &words[row * wordsPerRow];
+        for (size_t i = 0; i < wordsPerRow; i++) {
+            for (uint64_t word = from[i]; word != 0; word &= word - 1) {
+                f(i * 64 + lowestBit(word));
+            }
+        }
+    }
+
+private:
+    size_t rowCount;
+    size_t wordsPerRow;
+    std::vector<uint64_t> words;
+
+    static size_t lowestBit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+            return index;
+        _BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+        return index + 32;
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+};
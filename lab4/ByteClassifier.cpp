@@ -0,0 +1,256 @@
+#include "ByteClassifier.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BYTE_CLASSIFIER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSE2
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+using namespace std;
+
+
+static int lowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+ByteClassifier::ByteClassifier() : members{}, memberList{}, memberCount(0), lowNibbles{}, highNibbles{},
+	hasHighMembers(false), kernel(Kernel::Scalar)
+{
+}
+
+ByteClassifier::ByteClassifier(const std::array<bool, 256>& members) : members(members), memberList{}, memberCount(0),
+	lowNibbles{}, highNibbles{}, hasHighMembers(false)
+{
+	for (int ch = 0; ch < 256; ch++) {
+		if (!members[ch]) {
+			continue;
+		}
+		if (memberCount < MAX_SIMD_MEMBERS) {
+			memberList[memberCount] = static_cast<unsigned char>(ch);
+		}
+		memberCount++;
+		if (ch < 128) {
+			lowNibbles[ch & 15] |= static_cast<unsigned char>(1 << (ch >> 4));
+		}
+		else {
+			hasHighMembers = true;
+		}
+	}
+	for (int high = 0; high < 8; high++) {
+		highNibbles[high] = static_cast<unsigned char>(1 << high);
+	}
+	setKernel(detectKernel());
+}
+
+ByteClassifier::Kernel ByteClassifier::detectKernel()
+{
+#ifdef BYTE_CLASSIFIER_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	int highestLeaf = info[0];
+	__cpuid(info, 1);
+	bool ssse3 = (info[2] & (1 << 9)) != 0;
+	//the os has to save the ymm registers too, not only the cpu support them
+	bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+	if (highestLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		if (osSavesAvx && (info[1] & (1 << 5))) {
+			return Kernel::AVX2;
+		}
+	}
+	if (ssse3) {
+		return Kernel::SSSE3;
+	}
+#else
+	if (__builtin_cpu_supports("avx2")) {
+		return Kernel::AVX2;
+	}
+	if (__builtin_cpu_supports("ssse3")) {
+		return Kernel::SSSE3;
+	}
+#endif
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	return Kernel::SSE2;
+#endif
+#endif
+	return Kernel::Scalar;
+}
+
+void ByteClassifier::setKernel(Kernel wanted)
+{
+	Kernel best = detectKernel();
+	Kernel chosen = static_cast<int>(wanted) <= static_cast<int>(best) ? wanted : best;
+	//the nibble tables only cover ascii, the member comparisons only a few members,
+	//checked on the kernel actually chosen since an asked for sse2 can be below the best one
+	if ((chosen == Kernel::AVX2 || chosen == Kernel::SSSE3) && hasHighMembers) {
+		chosen = Kernel::SSE2;
+	}
+	if (chosen == Kernel::SSE2 && memberCount > MAX_SIMD_MEMBERS) {
+		chosen = Kernel::Scalar;
+	}
+	kernel = chosen;
+}
+
+const char* ByteClassifier::kernelName(Kernel kernel)
+{
+	switch (kernel) {
+	case Kernel::SSE2:
+		return "sse2";
+	case Kernel::SSSE3:
+		return "ssse3";
+	case Kernel::AVX2:
+		return "avx2";
+	default:
+		return "scalar";
+	}
+}
+
+size_t ByteClassifier::findFirstIn(const char* begin, const char* end) const
+{
+	return find(begin, end, true);
+}
+
+size_t ByteClassifier::findFirstNotIn(const char* begin, const char* end) const
+{
+	return find(begin, end, false);
+}
+
+size_t ByteClassifier::find(const char* begin, const char* end, bool inSet) const
+{
+	const char* prefixEnd = end - begin > SCALAR_PREFIX ? begin + SCALAR_PREFIX : end;
+	size_t prefix = findScalar(begin, prefixEnd, inSet);
+	if (begin + prefix < prefixEnd || prefixEnd == end) {
+		return prefix;
+	}
+
+	switch (kernel) {
+	case Kernel::AVX2:
+		return prefix + findAVX2(prefixEnd, end, inSet);
+	case Kernel::SSSE3:
+		return prefix + findSSSE3(prefixEnd, end, inSet);
+	case Kernel::SSE2:
+		return prefix + findSSE2(prefixEnd, end, inSet);
+	default:
+		return prefix + findScalar(prefixEnd, end, inSet);
+	}
+}
+
+size_t ByteClassifier::findScalar(const char* begin, const char* end, bool inSet) const
+{
+	const char* curr = begin;
+	while (curr < end && members[static_cast<unsigned char>(*curr)] != inSet) {
+		curr++;
+	}
+	return curr - begin;
+}
+
+#ifdef BYTE_CLASSIFIER_X86
+
+TARGET_SSE2 size_t ByteClassifier::findSSE2(const char* begin, const char* end, bool inSet) const
+{
+	__m128i sets[MAX_SIMD_MEMBERS];
+	for (int i = 0; i < memberCount; i++) {
+		sets[i] = _mm_set1_epi8(static_cast<char>(memberList[i]));
+	}
+
+	const char* curr = begin;
+	for (; end - curr >= 16; curr += 16) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr));
+		__m128i hits = _mm_setzero_si128();
+		for (int i = 0; i < memberCount; i++) {
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, sets[i]));
+		}
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+		if (!inSet) {
+			mask = ~mask & 0xFFFFu;
+		}
+		if (mask != 0) {
+			return (curr - begin) + lowestBit(mask);
+		}
+	}
+	return (curr - begin) + findScalar(curr, end, inSet);
+}
+
+TARGET_SSSE3 size_t ByteClassifier::findSSSE3(const char* begin, const char* end, bool inSet) const
+{
+	__m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lowNibbles));
+	__m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(highNibbles));
+	__m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+	const char* curr = begin;
+	for (; end - curr >= 16; curr += 16) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr));
+		//a byte with the top bit set picks 0 from the shuffle, so it is never a member
+		__m128i low = _mm_shuffle_epi8(lowTable, block);
+		__m128i high = _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask));
+		__m128i outside = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(outside));
+		if (inSet) {
+			mask = ~mask & 0xFFFFu;
+		}
+		if (mask != 0) {
+			return (curr - begin) + lowestBit(mask);
+		}
+	}
+	return (curr - begin) + findScalar(curr, end, inSet);
+}
+
+TARGET_AVX2 size_t ByteClassifier::findAVX2(const char* begin, const char* end, bool inSet) const
+{
+	__m256i lowTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lowNibbles)));
+	__m256i highTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(highNibbles)));
+	__m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+	const char* curr = begin;
+	for (; end - curr >= 32; curr += 32) {
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(curr));
+		//a byte with the top bit set picks 0 from the shuffle, so it is never a member
+		__m256i low = _mm256_shuffle_epi8(lowTable, block);
+		__m256i high = _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask));
+		__m256i outside = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(outside));
+		if (inSet) {
+			mask = ~mask;
+		}
+		if (mask != 0) {
+			return (curr - begin) + lowestBit(mask);
+		}
+	}
+	//the tail is shorter than a ymm register
+	return (curr - begin) + findScalar(curr, end, inSet);
+}
+
+#else
+
+size_t ByteClassifier::findSSE2(const char* begin, const char* end, bool inSet) const
+{
+	return findScalar(begin, end, inSet);
+}
+
+size_t ByteClassifier::findSSSE3(const char* begin, const char* end, bool inSet) const
+{
+	return findScalar(begin, end, inSet);
+}
+
+size_t ByteClassifier::findAVX2(const char* begin, const char* end, bool inSet) const
+{
+	return findScalar(begin, end, inSet);
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// finds the next byte that is (or is not) in a small set, 16 or 32 bytes at a time where the cpu allows it
+// the scanner uses it to jump to the delimiter that ends a token and over runs of skipped characters
+class ByteClassifier {
+public:
+    enum class Kernel { Scalar, SSE2, SSSE3, AVX2 };
+
+    // sse2 has no byte shuffle, so that kernel compares against every member and is only used without ssse3
+    // larger sets go through the scalar table there
+    static const int MAX_SIMD_MEMBERS = 16;
+    // most runs are short, this many bytes are looked up one by one before any vector is loaded
+    static const int SCALAR_PREFIX = 16;
+
+    ByteClassifier();
+    explicit ByteClassifier(const std::array<bool, 256>& members);
+
+    bool contains(unsigned char character) const { return members[character]; }
+
+    // offset of the first byte of [begin, end) in the set, end - begin if there is none
+    size_t findFirstIn(const char* begin, const char* end) const;
+    // offset of the first byte of [begin, end) that is not in the set, end - begin if there is none
+    size_t findFirstNotIn(const char* begin, const char* end) const;
+
+    Kernel getKernel() const { return kernel; }
+    // falls back to the best supported kernel when the asked one can't be used
+    void setKernel(Kernel wanted);
+    // the fastest kernel this cpu runs
+    static Kernel detectKernel();
+    static const char* kernelName(Kernel kernel);
+
+private:
+    std::array<bool, 256> members;
+    unsigned char memberList[MAX_SIMD_MEMBERS];
+    int memberCount;
+    // for the ssse3 and avx2 kernels: bit h of lowNibbles[l] is set when byte h * 16 + l is a member (h < 8),
+    // highNibbles[h] is 1 << h, so one shuffle on each nibble tests a whole vector
+    unsigned char lowNibbles[16];
+    unsigned char highNibbles[16];
+    bool hasHighMembers;
+    Kernel kernel;
+
+    size_t findScalar(const char* begin, const char* end, bool inSet) const;
+    size_t findSSE2(const char* begin, const char* end, bool inSet) const;
+    size_t findSSSE3(const char* begin, const char* end, bool inSet) const;
+    size_t findAVX2(const char* begin, const char* end, bool inSet) const;
+    size_t find(const char* begin, const char* end, bool inSet) const;
+};
@@ -0,0 +1,241 @@
+#include "ConcurrentSymbolTable.h"
+#include "HashTable.h"
+#include "Statistics.h"
+#include <cstring>
+#include <sstream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+// a shard grows once it is more than 3/4 full, linear probing gets slow sooner than robin hood does
+static const size_t MAX_LOAD_NUMERATOR = 3;
+static const size_t MAX_LOAD_DENOMINATOR = 4;
+static const size_t BLOCK_SIZE = 1 << 16;
+
+static int highestBit(uint32_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, value);
+	return static_cast<int>(index);
+#else
+	return 31 - __builtin_clz(value);
+#endif
+}
+
+ConcurrentSymbolTable::Slots::Slots(size_t capacity) : capacity(capacity), slots(new atomic<uint64_t>[capacity])
+{
+	for (size_t i = 0; i < capacity; i++) {
+		slots[i].store(0, memory_order_relaxed);
+	}
+}
+
+ConcurrentSymbolTable::ConcurrentSymbolTable(int size) : nextId(0)
+{
+	//the expected symbols spread evenly over the shards
+	size_t capacity = 16;
+	while (capacity * SHARD_COUNT * MAX_LOAD_NUMERATOR < static_cast<size_t>(size) * MAX_LOAD_DENOMINATOR) {
+		capacity *= 2;
+	}
+	for (Shard& shard : shards) {
+		shard.tables.emplace_back(new Slots(capacity));
+		shard.slots.store(shard.tables.back().get(), memory_order_relaxed);
+		shard.count = 0;
+		shard.blockUsed = 0;
+		shard.blockSize = 0;
+	}
+	for (atomic<Symbol*>& segment : segments) {
+		segment.store(nullptr, memory_order_relaxed);
+	}
+}
+
+ConcurrentSymbolTable::~ConcurrentSymbolTable()
+{
+	for (atomic<Symbol*>& segment : segments) {
+		delete[] segment.load(memory_order_relaxed);
+	}
+}
+
+void ConcurrentSymbolTable::segmentOf(int id, int& segment, size_t& index)
+{
+	uint32_t position = static_cast<uint32_t>(id) + (1u << FIRST_SEGMENT_BITS);
+	segment = highestBit(position) - FIRST_SEGMENT_BITS;
+	index = position - (1u << (segment + FIRST_SEGMENT_BITS));
+}
+
+const ConcurrentSymbolTable::Symbol& ConcurrentSymbolTable::symbol(int id) const
+{
+	int segment;
+	size_t index;
+	segmentOf(id, segment, index);
+	return segments[segment].load(memory_order_acquire)[index];
+}
+
+int ConcurrentSymbolTable::findIn(const Slots& table, const char* key, size_t length, uint32_t hash, size_t& index) const
+{
+	STATS_ADD(SymbolLookups, 1);
+	size_t mask = table.capacity - 1;
+	index = hash & mask;
+	for (size_t distance = 0; ; distance++) {
+		//acquire, so the symbol the slot points to is all there
+		uint64_t slot = table.slots[index].load(memory_order_acquire);
+		if (slot == 0) {
+			STATS_RECORD(ProbeLength, distance);
+			return -1;
+		}
+		if (static_cast<uint32_t>(slot >> 32) == hash) {
+			int id = static_cast<int>(static_cast<uint32_t>(slot)) - 1;
+			const Symbol& candidate = symbol(id);
+			if (candidate.length == length && memcmp(candidate.data, key, length) == 0) {
+				STATS_RECORD(ProbeLength, distance);
+				return id;
+			}
+		}
+		index = (index + 1) & mask;
+	}
+}
+
+int ConcurrentSymbolTable::find(const char* key, size_t length) const
+{
+	uint64_t hash = HashTable::hashFunction(key, length);
+	const Shard& shard = shards[hash >> (64 - SHARD_BITS)];
+	size_t index;
+	return findIn(*shard.slots.load(memory_order_acquire), key, length, static_cast<uint32_t>(hash), index);
+}
+
+int ConcurrentSymbolTable::findOrInsert(const char* key, size_t length)
+{
+	uint64_t hash = HashTable::hashFunction(key, length);
+	uint32_t slotHash = static_cast<uint32_t>(hash);
+	Shard& shard = shards[hash >> (64 - SHARD_BITS)];
+
+	//most symbols of a program are seen again and again, those never take the lock
+	size_t index;
+	int id = findIn(*shard.slots.load(memory_order_acquire), key, length, slotHash, index);
+	if (id >= 0) {
+		return id;
+	}
+
+	lock_guard<mutex> guard(shard.lock);
+	//another thread may have inserted it while we waited, or the shard grew since the first look
+	Slots* table = shard.slots.load(memory_order_relaxed);
+	id = findIn(*table, key, length, slotHash, index);
+	if (id >= 0) {
+		return id;
+	}
+	if ((shard.count + 1) * MAX_LOAD_DENOMINATOR > table->capacity * MAX_LOAD_NUMERATOR) {
+		grow(shard);
+		table = shard.slots.load(memory_order_relaxed);
+		findIn(*table, key, length, slotHash, index);
+	}
+
+	id = addSymbol(store(shard, key, length), length);
+	shard.count++;
+	STATS_ADD(SymbolInserts, 1);
+
+	//release, readers that find the slot also see the symbol
+	table->slots[index].store(static_cast<uint64_t>(slotHash) << 32 | static_cast<uint32_t>(id + 1), memory_order_release);
+	return id;
+}
+
+void ConcurrentSymbolTable::grow(Shard& shard)
+{
+	STATS_ADD(Rehashes, 1);
+	const Slots& old = *shard.slots.load(memory_order_relaxed);
+	Slots* table = new Slots(old.capacity * 2);
+	shard.tables.emplace_back(table);
+
+	//only the holder of the lock writes to the shard, nothing changes under us
+	size_t mask = table->capacity - 1;
+	for (size_t i = 0; i < old.capacity; i++) {
+		uint64_t slot = old.slots[i].load(memory_order_relaxed);
+		if (slot == 0) {
+			continue;
+		}
+		size_t index = static_cast<uint32_t>(slot >> 32) & mask;
+		while (table->slots[index].load(memory_order_relaxed) != 0) {
+			index = (index + 1) & mask;
+		}
+		table->slots[index].store(slot, memory_order_relaxed);
+	}
+
+	//readers still in the old table finish there, a key they miss is looked up again under the lock
+	shard.slots.store(table, memory_order_release);
+}
+
+const char* ConcurrentSymbolTable::store(Shard& shard, const char* key, size_t length)
+{
+	if (shard.blockSize - shard.blockUsed < length) {
+		shard.blockSize = max(BLOCK_SIZE, length);
+		shard.blockUsed = 0;
+		shard.blocks.emplace_back(new char[shard.blockSize]);
+	}
+	char* data = shard.blocks.back().get() + shard.blockUsed;
+	memcpy(data, key, length);
+	shard.blockUsed += length;
+	return data;
+}
+
+int ConcurrentSymbolTable::addSymbol(const char* data, size_t length)
+{
+	int id = nextId.fetch_add(1, memory_order_relaxed);
+	int segment;
+	size_t index;
+	segmentOf(id, segment, index);
+
+	//the first symbol of a segment may be added by two shards at once, one of them allocates it
+	Symbol* symbols = segments[segment].load(memory_order_acquire);
+	if (symbols == nullptr) {
+		Symbol* allocated = new Symbol[size_t(1) << (segment + FIRST_SEGMENT_BITS)];
+		if (segments[segment].compare_exchange_strong(symbols, allocated, memory_order_acq_rel)) {
+			symbols = allocated;
+		}
+		else {
+			delete[] allocated;
+		}
+	}
+	symbols[index] = { data, static_cast<uint32_t>(length) };
+	return id;
+}
+
+string ConcurrentSymbolTable::getSymbol(int id) const
+{
+	const Symbol& found = symbol(id);
+	return string(found.data, found.length);
+}
+
+double ConcurrentSymbolTable::loadFactor() const
+{
+	size_t capacity = 0;
+	for (const Shard& shard : shards) {
+		capacity += shard.slots.load(memory_order_acquire)->capacity;
+	}
+	return static_cast<double>(size()) / capacity;
+}
+
+string ConcurrentSymbolTable::display() const
+{
+	ostringstream oss;
+	for (int id = 0; id < size(); id++) {
+		oss << "Position " << id << ": " << getSymbolView(id) << endl;
+	}
+	return oss.str();
+}
+
+void ConcurrentSymbolTable::recordStatistics() const
+{
+	Statistics::set(Statistics::Gauge::SymbolTableLoadFactor, loadFactor());
+	Statistics::set(Statistics::Gauge::SymbolTableSize, size());
+	Statistics::clear(Statistics::Histogram::Displacement);
+	for (const Shard& shard : shards) {
+		const Slots& table = *shard.slots.load(memory_order_acquire);
+		for (size_t index = 0; index < table.capacity; index++) {
+			uint64_t slot = table.slots[index].load(memory_order_relaxed);
+			if (slot != 0) {
+				size_t home = static_cast<uint32_t>(slot >> 32) & (table.capacity - 1);
+				Statistics::record(Statistics::Histogram::Displacement, (index - home) & (table.capacity - 1));
+			}
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+
+// symbol table that many scanners on different threads can fill at the same time
+// the symbols are split over shards by hash, inserting takes the lock of one shard only and looking up
+// takes no lock at all, so threads only wait for each other when they insert into the same shard
+// every symbol gets an id the first time it is inserted, ids never change and symbols are never removed,
+// so an id handed to one thread stays valid for all of them
+//
+// unlike HashTable the ids depend on the order the threads got to the symbols, not only on the input
+class ConcurrentSymbolTable {
+public:
+    explicit ConcurrentSymbolTable(int size = 100);
+    ~ConcurrentSymbolTable();
+    ConcurrentSymbolTable(const ConcurrentSymbolTable&) = delete;
+    ConcurrentSymbolTable& operator=(const ConcurrentSymbolTable&) = delete;
+
+    // id of the key, the key is inserted first if it is not in the table yet
+    int findOrInsert(const char* key, size_t length);
+    int findOrInsert(std::string_view key) { return findOrInsert(key.data(), key.size()); }
+    // id of the key, -1 if it is not in the table, never waits for an insert
+    int find(const char* key, size_t length) const;
+    int searchElem(std::string_view key) const { return find(key.data(), key.size()); }
+
+    // the text of an id stays where it is for as long as the table lives
+    const char* getSymbolData(int id) const { return symbol(id).data; }
+    size_t getSymbolLength(int id) const { return symbol(id).length; }
+    std::string getSymbol(int id) const;
+    std::string_view getSymbolView(int id) const { return std::string_view(getSymbolData(id), getSymbolLength(id)); }
+    int size() const { return nextId.load(std::memory_order_acquire); }
+    double loadFactor() const;
+
+    // these two look at every symbol, they are only meant for once no thread is inserting anymore
+    std::string display() const;
+    void recordStatistics() const;
+
+private:
+    struct Symbol {
+        const char* data;
+        uint32_t length;
+    };
+
+    // a slot is the low half of the hash and id + 1 of its symbol, 0 for an empty slot,
+    // one word so a reader sees either all of it or nothing
+    struct Slots {
+        size_t capacity;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+
+        explicit Slots(size_t capacity);
+    };
+
+    // on a cache line of its own, so inserts into different shards don't slow each other down
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::atomic<Slots*> slots;
+        int count;
+        // a reader may still probe a table the shard outgrew, so they are only freed with the whole table
+        std::vector<std::unique_ptr<Slots>> tables;
+        // the symbols of the shard, in blocks that are never moved
+        std::vector<std::unique_ptr<char[]>> blocks;
+        size_t blockUsed;
+        size_t blockSize;
+    };
+
+    static const int SHARD_BITS = 6;
+    static const int SHARD_COUNT = 1 << SHARD_BITS;
+    // id -> symbol is kept in segments that double in size, so a segment never moves once it exists
+    static const int FIRST_SEGMENT_BITS = 10;
+    static const int SEGMENT_COUNT = 32 - FIRST_SEGMENT_BITS;
+
+    Shard shards[SHARD_COUNT];
+    std::atomic<int> nextId;
+    std::atomic<Symbol*> segments[SEGMENT_COUNT];
+
+    static void segmentOf(int id, int& segment, size_t& index);
+    const Symbol& symbol(int id) const;
+    int findIn(const Slots& table, const char* key, size_t length, uint32_t hash, size_t& index) const;
+    void grow(Shard& shard);
+    const char* store(Shard& shard, const char* key, size_t length);
+    int addSymbol(const char* data, size_t length);
+};
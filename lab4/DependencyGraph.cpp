@@ -0,0 +1,116 @@
+#include "DependencyGraph.h"
+#include "Statistics.h"
+#include <algorithm>
+using namespace std;
+
+
+DependencyGraph::DependencyGraph(int nodeCount, const std::vector<std::pair<int, int>>& pairs)
+	: edgeStart(nodeCount + 1, 0), edges(pairs.size())
+{
+	for (const auto& edge : pairs) {
+		edgeStart[edge.first + 1]++;
+	}
+	for (int node = 0; node < nodeCount; node++) {
+		edgeStart[node + 1] += edgeStart[node];
+	}
+	vector<int> next(edgeStart.begin(), edgeStart.end() - 1);
+	for (const auto& edge : pairs) {
+		edges[next[edge.first]++] = edge.second;
+	}
+}
+
+void stronglyConnected(const DependencyGraph& graph, vector<int>& componentOf, vector<int>& componentStart, vector<int>& members)
+{
+	int n = graph.nodeCount();
+	vector<int> index(n, -1), low(n, 0);
+	vector<char> onStack(n, 0);
+	vector<int> stack;
+	vector<pair<int, int>> calls;   // node, next edge to look at
+	int counter = 0;
+
+	componentOf.assign(n, -1);
+	componentStart.assign(1, 0);
+	members.clear();
+
+	for (int root = 0; root < n; root++) {
+		if (index[root] >= 0) {
+			continue;
+		}
+		index[root] = low[root] = counter++;
+		stack.push_back(root);
+		onStack[root] = 1;
+		calls.push_back({ root, graph.edgeStart[root] });
+
+		while (!calls.empty()) {
+			int node = calls.back().first;
+			int edge = calls.back().second;
+
+			if (edge < graph.edgeStart[node + 1]) {
+				calls.back().second++;
+				int target = graph.edges[edge];
+				if (index[target] < 0) {
+					index[target] = low[target] = counter++;
+					stack.push_back(target);
+					onStack[target] = 1;
+					calls.push_back({ target, graph.edgeStart[target] });
+				}
+				else if (onStack[target]) {
+					low[node] = min(low[node], index[target]);
+				}
+				continue;
+			}
+
+			if (low[node] == index[node]) {
+				int component = static_cast<int>(componentStart.size()) - 1;
+				int member;
+				do {
+					member = stack.back();
+					stack.pop_back();
+					onStack[member] = 0;
+					componentOf[member] = component;
+					members.push_back(member);
+				} while (member != node);
+				componentStart.push_back(static_cast<int>(members.size()));
+			}
+			calls.pop_back();
+			if (!calls.empty()) {
+				int parent = calls.back().first;
+				low[parent] = min(low[parent], low[node]);
+			}
+		}
+	}
+}
+
+void propagate(const DependencyGraph& graph, BitMatrix& sets, long long except)
+{
+	vector<int> componentOf, componentStart, members;
+	stronglyConnected(graph, componentOf, componentStart, members);
+	STATS_ADD(Components, componentStart.size() - 1);
+
+	for (size_t component = 0; component + 1 < componentStart.size(); component++) {
+		int first = componentStart[component];
+		int last = componentStart[component + 1];
+		int representative = members[first];
+
+		for (int i = first; i < last; i++) {
+			int member = members[i];
+			if (member != representative) {
+				sets.unite(representative, member, except);
+				STATS_ADD(SetUnions, 1);
+			}
+			for (int edge = graph.edgeStart[member]; edge < graph.edgeStart[member + 1]; edge++) {
+				int target = graph.edges[edge];
+				if (componentOf[target] != static_cast<int>(component)) {
+					sets.unite(representative, target, except);
+					STATS_ADD(SetUnions, 1);
+				}
+			}
+		}
+		for (int i = first; i < last; i++) {
+			if (members[i] != representative) {
+				sets.unite(members[i], representative);
+				STATS_ADD(SetUnions, 1);
+			}
+		}
+	}
+}
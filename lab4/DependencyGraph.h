@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "BitMatrix.h"
+
+// edges between numbered nodes, grouped by source
+// the grammar analyses are all "set of a includes set of b" over such a graph
+struct DependencyGraph {
+    std::vector<int> edgeStart;
+    std::vector<int> edges;
+
+    DependencyGraph(int nodeCount, const std::vector<std::pair<int, int>>& pairs);
+    int nodeCount() const { return static_cast<int>(edgeStart.size()) - 1; }
+};
+
+// tarjan's algorithm without recursion, so long chains of nodes can't overflow the stack
+// components come out with every component after all of the ones it has an edge to,
+// members holds them one after the other and componentStart says where each one begins
+void stronglyConnected(const DependencyGraph& graph, std::vector<int>& componentOf, std::vector<int>& componentStart, std::vector<int>& members);
+
+// solves sets[a] includes sets[b] (leaving out the except bit) for every edge a -> b
+// the members of a cycle all end up with the same set, so each component is merged once and copied out,
+// after the components it depends on are already final
+void propagate(const DependencyGraph& graph, BitMatrix& sets, long long except = -1);
@@ -1,4 +1,6 @@
 #include "FiniteAutomata.h"
+#include "NFA.h"
+#include "Statistics.h"
 #include <fstream>
 using namespace std;
 
@@ -72,11 +74,13 @@ void FA::init(string filepath) {
 				symbols[symbols.size() - 1] = removeFromString(symbols[symbols.size() - 1], ']');
 
 				for (const string& symbol : symbols) {
-					this->transitions[fromState][symbol] = toState;
+					this->transitions[fromState][symbol].insert(toState);
 				}
 			}
 		}
 	}
+
+	this->compile();
 }
 
 string FA::expand(std::string expand)
@@ -115,38 +119,80 @@ FA::FA()
 {
 }
 
-bool FA::checkIfConsistent(std::string toCheck)
+bool FA::checkIfConsistent(std::string_view toCheck) const
 {
-	currentState = initialState;
-	for (size_t i = 0; i < toCheck.size(); ++i) {
-		char ch = toCheck[i];
-		bool foundTransition = false;
-
-		for (const auto& entry : alphabetMap) {
-			//find what variable character is part of
-			if (entry.first.find(ch) != std::string::npos) {
-				
-				//find to which state current character leads
-				if (this->transitions[currentState][entry.second] != "") {
-					currentState = this->transitions[currentState][entry.second];
-					foundTransition = true;
-				}
-				
-				//we found type of char we can break
-				break;
+	int state = table.initialState;
+	if (state < 0)
+		return false;
+
+	for (size_t i = 0; i < toCheck.size(); i++) {
+		state = table.step(state, static_cast<unsigned char>(toCheck[i]));
+		if (state < 0) {
+			STATS_ADD(AutomatonTransitions, i + 1);
+			return false;
+		}
+	}
+	STATS_ADD(AutomatonTransitions, toCheck.size());
+
+	//the string is consistent if we stopped in a final state
+	return table.isAccepting(state);
+}
+
+void FA::compile()
+{
+	//give every state a dense id, states only mentioned in transitions are included as well
+	set<string> names(states.begin(), states.end());
+	if (!initialState.empty())
+		names.insert(initialState);
+	names.insert(finalStates.begin(), finalStates.end());
+	for (const auto& fromState : transitions) {
+		names.insert(fromState.first);
+		for (const auto& symbol : fromState.second)
+			names.insert(symbol.second.begin(), symbol.second.end());
+	}
+
+	NFA nfa;
+	unordered_map<string, int> stateIds;
+	for (const string& name : names)
+		stateIds[name] = nfa.addState(finalStates.count(name) ? 0 : -1);
+
+	//characters of every alias, a character listed under two aliases stays with the first one
+	unordered_map<string, bitset<256>> aliasBytes;
+	bitset<256> claimed;
+	for (const auto& entry : alphabetMap) {
+		bitset<256>& bytes = aliasBytes[entry.second];
+		for (char ch : entry.first) {
+			unsigned char byte = static_cast<unsigned char>(ch);
+			if (!claimed.test(byte)) {
+				claimed.set(byte);
+				bytes.set(byte);
 			}
-			
+		}
+	}
 
+	for (const auto& fromState : transitions) {
+		for (const auto& symbol : fromState.second) {
+			auto bytes = aliasBytes.find(symbol.first);
+
+			//an alias that is not in the alphabet can never be read
+			if (bytes == aliasBytes.end())
+				continue;
+			for (const string& toState : symbol.second)
+				nfa.addEdge(stateIds[fromState.first], bytes->second, stateIds[toState]);
 		}
-		if (!foundTransition)
-			return false;
 	}
 
-	//we find if the final state is a final state, if it is, it means the given string is consistent
-	if (std::find(finalStates.begin(), finalStates.end(), currentState) != finalStates.end()) {
-		return true;
+	specStateCount = static_cast<int>(names.size());
+	auto initial = stateIds.find(initialState);
+	if (initial == stateIds.end()) {
+		table = DFATable();
+		determinizedStateCount = 0;
+		return;
 	}
-	return false;
+
+	DFATable dfa = nfa.determinize(initial->second);
+	determinizedStateCount = dfa.stateCount;
+	table = minimizeDFA(dfa);
 }
 
 
@@ -170,7 +216,9 @@ void FA::displayTransitions() const {
 	std::cout << "Transitions:\n";
 	for (const auto& fromState : transitions) {
 		for (const auto& symbol : fromState.second) {
-			std::cout << fromState.first << " --" << symbol.first << "--> " << symbol.second << "\n";
+			for (const auto& toState : symbol.second) {
+				std::cout << fromState.first << " --" << symbol.first << "--> " << toState << "\n";
+			}
 		}
 	}
 }
@@ -185,4 +233,9 @@ void FA::displayFinalStates() const {
 		std::cout << state << " ";
 	}
 	std::cout << std::endl;
+}
+
+void FA::displayMinimizationReport() const {
+	std::cout << "States: " << specStateCount << " in the spec, " << determinizedStateCount
+		<< " after subset construction, " << table.stateCount << " after minimization" << std::endl;
 }
\ No newline at end of file
@@ -1,12 +1,33 @@
 // FiniteAutomata.h
 #pragma once
 #include <string>
+#include <string_view>
+#include <set>
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
+#include <array>
+#include <vector>
 #include <iostream>
 #include "Tokenize.h"
 
+// dense table form of an automaton: one class lookup and one transition load per byte
+struct DFATable {
+    std::array<int, 256> charClass{};   // byte -> character class, class 0 is "not in the alphabet"
+    int classCount = 1;
+    int stateCount = 0;
+    int initialState = -1;
+    std::vector<int> next;              // stateCount x classCount, -1 means there is no transition
+    std::vector<int> accept;            // per state, -1 if the state is not final
+
+    int step(int state, unsigned char character) const {
+        return next[state * classCount + charClass[character]];
+    }
+    bool isAccepting(int state) const {
+        return accept[state] >= 0;
+    }
+};
+
 class FA {
 private:
    void init(std::string filepath);
@@ -14,19 +35,28 @@ private:
     std::unordered_map<std::string, std::string> alphabetMap;
     std::string initialState;
     std::unordered_set<std::string> finalStates;
-    std::map<std::string, std::map<std::string, std::string>> transitions;
-    std::string currentState;
+    //a state may have several targets for the same symbol, the automaton is determinized on load
+    std::map<std::string, std::map<std::string, std::set<std::string>>> transitions;
     bool isInside(char character, std::string toSearchIn);
     std::string expand(std::string expand);
 
+    //compiled form of the maps above, built once at the end of init
+    //it is the minimal DFA accepting the same language as the spec
+    DFATable table;
+    int specStateCount = 0;
+    int determinizedStateCount = 0;
+    void compile();
+
 
 public:
     FA(std::string filepath);
     FA();
-    bool checkIfConsistent(std::string toCheck);
+    bool checkIfConsistent(std::string_view toCheck) const;
+    const DFATable& getTable() const { return table; }
     void displayStates() const;
     void displayAlphabet() const;
     void displayTransitions() const;
     void displayInitialState() const;
     void displayFinalStates() const;
+    void displayMinimizationReport() const;
 };
\ No newline at end of file
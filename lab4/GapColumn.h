@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+// column of integers with a gap of unused entries in it, for tables that are changed at one place at a time
+// replace leaves the gap right after the entries it put in, so the next change only moves the entries between the two
+// the entries after the gap can all be moved by one shift, they are kept as they were and the shift is added when read
+template <class T>
+class GapColumn {
+public:
+    GapColumn() : gapIndex(0), gapLength(0), afterGapShift(0) {}
+
+    size_t size() const { return values.size() - gapLength; }
+    T get(size_t index) const {
+        return index < gapIndex ? values[index] : static_cast<T>(values[index + gapLength] + afterGapShift);
+    }
+    void set(size_t index, T value) {
+        if (index < gapIndex)
+            values[index] = value;
+        else
+            values[index + gapLength] = static_cast<T>(value - afterGapShift);
+    }
+    // adds an entry at the end, which is after the gap
+    void push_back(T value) { values.push_back(static_cast<T>(value - afterGapShift)); }
+
+    void clear() {
+        values.clear();
+        gapIndex = 0;
+        gapLength = 0;
+        afterGapShift = 0;
+    }
+    void reserve(size_t count) { values.reserve(count + gapLength); }
+
+    // replaces the entries [begin, end) with count new ones, which are set by the caller afterwards
+    void replace(size_t begin, size_t end, size_t count) {
+        //the replaced entries join the gap and the new ones are taken from the start of it
+        moveGap(end);
+        gapIndex = begin;
+        gapLength += end - begin;
+        growGap(count);
+        gapIndex += count;
+        gapLength -= count;
+    }
+    // adds shift to every entry after the gap
+    void shiftAfterGap(long long shift) { afterGapShift += shift; }
+    // moves the entries after the gap next to the ones before it
+    void closeGap() {
+        moveGap(size());
+        values.resize(gapIndex);
+        gapLength = 0;
+        afterGapShift = 0;
+    }
+
+private:
+    std::vector<T> values;
+    // the entries [gapIndex, gapIndex + gapLength) are unused
+    size_t gapIndex;
+    size_t gapLength;
+    // added to the entries after the gap
+    long long afterGapShift;
+
+    void moveGap(size_t index) {
+        //the entries that go from one side of the gap to the other take the shift in or out
+        if (index < gapIndex) {
+            for (size_t i = index; i < gapIndex && afterGapShift != 0; i++) {
+                values[i] = static_cast<T>(values[i] - afterGapShift);
+            }
+            std::copy_backward(values.begin() + index, values.begin() + gapIndex, values.begin() + gapIndex + gapLength);
+        }
+        else if (index > gapIndex) {
+            size_t from = gapIndex + gapLength;
+            for (size_t i = from; i < index + gapLength && afterGapShift != 0; i++) {
+                values[i] = static_cast<T>(values[i] + afterGapShift);
+            }
+            std::copy(values.begin() + from, values.begin() + index + gapLength, values.begin() + gapIndex);
+        }
+        gapIndex = index;
+    }
+
+    void growGap(size_t needed) {
+        if (gapLength >= needed)
+            return;
+
+        //growing with the size of the column keeps the copying to a constant per added entry
+        size_t grow = std::max(needed, size() / 8 + 256) - gapLength;
+        values.insert(values.begin() + gapIndex, grow, T());
+        gapLength += grow;
+    }
+};
@@ -1,22 +1,44 @@
 #include "Grammar.h"
+#include "DependencyGraph.h"
+#include "Statistics.h"
 using namespace std;
 
-bool Grammar::addToSet(set<string>& targetSet, const set<string>& sourceSet)
+Grammar::Grammar() : startSymbol(-1), epsilon(-1)
 {
-	size_t oldSize = targetSet.size();
-	targetSet.insert(sourceSet.begin(), sourceSet.end());
-	return targetSet.size() > oldSize;
+	rhsStart.assign(1, 0);
+	epsilon = internSymbol("e");
+	indexProductions();
+}
 
+int Grammar::internSymbol(const string& name)
+{
+	auto found = symbolIds.find(name);
+	if (found != symbolIds.end()) {
+		return found->second;
+	}
+
+	int id = static_cast<int>(symbolNames.size());
+	symbolIds.insert({ name, id });
+	symbolNames.push_back(name);
+	terminalFlags.push_back(0);
+	nonTerminalFlags.push_back(0);
+	return id;
 }
 
-Grammar::Grammar() : startSymbol("") {}
+int Grammar::findSymbol(const string& name) const
+{
+	auto found = symbolIds.find(name);
+	return found != symbolIds.end() ? found->second : -1;
+}
 
 bool Grammar::isTerminal(const string& symbol) const {
-	return terminals.find(symbol) != terminals.end();
+	int id = findSymbol(symbol);
+	return id >= 0 && isTerminal(id);
 }
 
 bool Grammar::isNonTerminal(const string& symbol) const {
-	return nonTerminals.find(symbol) != nonTerminals.end();
+	int id = findSymbol(symbol);
+	return id >= 0 && isNonTerminal(id);
 }
 
 vector<string> Grammar::splitProduction(const string& production) const {
@@ -32,6 +54,7 @@ vector<string> Grammar::splitProduction(const string& production) const {
 }
 
 bool Grammar::readFromFile(const string& filename) {
+	STATS_PHASE(ReadGrammar);
 	ifstream file(filename);
 	if (!file.is_open()) {
 
@@ -39,9 +62,15 @@ bool Grammar::readFromFile(const string& filename) {
 		return false;
 	}
 
-	nonTerminals.clear();
-	terminals.clear();
-	productions.clear();
+	symbolNames.clear();
+	symbolIds.clear();
+	terminalFlags.clear();
+	nonTerminalFlags.clear();
+	productionLhs.clear();
+	rhsStart.assign(1, 0);
+	rhsSymbols.clear();
+	startSymbol = -1;
+	epsilon = internSymbol("e");
 
 	string line;
 	// 0 non-terminals, 1 terminals, 2 start symbol, 3 productions
@@ -57,16 +86,16 @@ bool Grammar::readFromFile(const string& filename) {
 
 		switch (section) {
 		case 0:
-			nonTerminals.insert(line);
+			nonTerminalFlags[internSymbol(line)] = 1;
 			break;
 
 		case 1:
-			terminals.insert(line);
+			terminalFlags[internSymbol(line)] = 1;
 			break;
 
 		case 2:
-			if (nonTerminals.find(line) != nonTerminals.end()) {
-				startSymbol = line;
+			if (isNonTerminal(line)) {
+				startSymbol = symbolIds[line];
 			}
 			else {
 				cerr << "Line " << lineNum << " Start symbol must be non-terminal" << endl;
@@ -85,28 +114,36 @@ bool Grammar::readFromFile(const string& filename) {
 			string lhs = line.substr(0, arrowPos);
 
 			vector<string> lhsSymbols = splitProduction(lhs);
-			if (lhsSymbols.size() != 1 || nonTerminals.find(lhsSymbols[0]) == nonTerminals.end()) {
+			if (lhsSymbols.size() != 1 || !isNonTerminal(lhsSymbols[0])) {
 				isCFG = false;
 			}
 
 			for (string lhsSymbol : lhsSymbols) {
-				if (terminals.find(lhsSymbol) == terminals.end() && nonTerminals.find(lhsSymbol) == nonTerminals.end()) {
+				if (!isTerminal(lhsSymbol) && !isNonTerminal(lhsSymbol)) {
 					cerr << "Line " << lineNum << " Non defined symbol on lhs" << endl;
 					return false;
 				}
 			}
+			if (lhsSymbols.empty()) {
+				cerr << "Line " << lineNum << " Non defined symbol on lhs" << endl;
+				return false;
+			}
 
 			string rhs = line.substr(arrowPos + 2);
-			vector<string> rhsSymbols = splitProduction(rhs);
-			for (const string& symbol : rhsSymbols) {
-				if (nonTerminals.find(symbol) == nonTerminals.end() && terminals.find(symbol) == terminals.end()) {
+			vector<string> rhsNames = splitProduction(rhs);
+			for (const string& symbol : rhsNames) {
+				if (!isNonTerminal(symbol) && !isTerminal(symbol)) {
 					cerr << "Line " << lineNum << " Non defined symbol(s) on rhs" << endl;
 					return false;
 				}
 			}
 
-			//if we get here lhsSymbols will have size 1 surely.
-			productions[lhsSymbols[0]].push_back(splitProduction(rhs));
+			//the first symbol of a non context free lhs stands for all of it, like it always did
+			productionLhs.push_back(symbolIds[lhsSymbols[0]]);
+			for (const string& symbol : rhsNames) {
+				rhsSymbols.push_back(symbolIds[symbol]);
+			}
+			rhsStart.push_back(static_cast<int>(rhsSymbols.size()));
 		}
 		break;
 		}
@@ -116,56 +153,84 @@ bool Grammar::readFromFile(const string& filename) {
 	}
 
 	file.close();
+	indexProductions();
 	return true;
 }
 
+void Grammar::indexProductions()
+{
+	//counting sort of the productions by left hand side, which keeps them in the order they were read
+	lhsStart.assign(symbolNames.size() + 1, 0);
+	for (int lhs : productionLhs) {
+		lhsStart[lhs + 1]++;
+	}
+	for (size_t i = 1; i < lhsStart.size(); i++) {
+		lhsStart[i] += lhsStart[i - 1];
+	}
+	lhsProductions.assign(productionLhs.size(), 0);
+	vector<int> next(lhsStart.begin(), lhsStart.end() - 1);
+	for (int production = 0; production < productionCount(); production++) {
+		lhsProductions[next[productionLhs[production]]++] = production;
+	}
+}
+
+vector<int> Grammar::sortedSymbols() const
+{
+	vector<int> sorted(symbolNames.size());
+	for (size_t i = 0; i < sorted.size(); i++) {
+		sorted[i] = static_cast<int>(i);
+	}
+	sort(sorted.begin(), sorted.end(), [&](int a, int b) { return symbolNames[a] < symbolNames[b]; });
+	return sorted;
+}
+
 void Grammar::printNonTerminals() const {
 	cout << "Non-terminals: ";
-	for (const auto& nt : nonTerminals) {
-		cout << nt << " ";
+	for (int nt : sortedSymbols()) {
+		if (isNonTerminal(nt)) {
+			cout << symbolNames[nt] << " ";
+		}
 	}
 	cout << endl;
 }
 
 void Grammar::printTerminals() const {
 	cout << "Terminals: ";
-	for (const auto& t : terminals) {
-		cout << t << " ";
+	for (int t : sortedSymbols()) {
+		if (isTerminal(t)) {
+			cout << symbolNames[t] << " ";
+		}
+	}
+	cout << endl;
+}
+
+void Grammar::printProduction(int production) const {
+	cout << symbolNames[productionLhs[production]] << " -> ";
+	for (const int* symbol = rhsBegin(production); symbol != rhsEnd(production); ++symbol) {
+		cout << symbolNames[*symbol] << " ";
 	}
 	cout << endl;
 }
 
 void Grammar::printProductions() const {
 	cout << "Productions:" << endl;
-	for (auto it = productions.begin(); it != productions.end(); ++it) {
-		const string& currentNonTerminal = it->first;
-		const vector<vector<string>>& productionList = it->second;
-
-		for (auto prodIt = productionList.begin(); prodIt != productionList.end(); ++prodIt) {
-			cout << currentNonTerminal << " -> ";
-			for (auto symbolIt = prodIt->begin(); symbolIt != prodIt->end(); ++symbolIt) {
-				cout << *symbolIt << " ";
-			}
-			cout << endl;
+	for (int lhs : sortedSymbols()) {
+		for (const int* production = productionsBegin(lhs); production != productionsEnd(lhs); ++production) {
+			printProduction(*production);
 		}
 	}
 }
 
 void Grammar::printProductionsFor(const string& nonTerminal) const {
-	auto it = productions.find(nonTerminal);
-	if (it == productions.end()) {
+	int lhs = findSymbol(nonTerminal);
+	if (lhs < 0 || productionsBegin(lhs) == productionsEnd(lhs)) {
 		cout << "No productions for " << nonTerminal << endl;
 		return;
 	}
 
 	cout << "Productions for " << nonTerminal << ":" << endl;
-	const vector<vector<string>>& productionList = it->second;
-	for (auto prodIt = productionList.begin(); prodIt != productionList.end(); ++prodIt) {
-		cout << nonTerminal << " -> ";
-		for (auto symbolIt = prodIt->begin(); symbolIt != prodIt->end(); ++symbolIt) {
-			cout << *symbolIt << " ";
-		}
-		cout << endl;
+	for (const int* production = productionsBegin(lhs); production != productionsEnd(lhs); ++production) {
+		printProduction(*production);
 	}
 }
 
@@ -174,144 +239,188 @@ bool Grammar::checkCFG() const {
 }
 
 void Grammar::computeFirst() {
-	firstSets.clear();
-
-	for (const string& terminal : terminals) {
-		firstSets[terminal].insert(terminal);
+	STATS_PHASE(ComputeFirst);
+	int n = symbolCount();
+	firstSets.reset(n, n);
+	hasFirst.assign(n, 0);
+
+	for (int symbol = 0; symbol < n; symbol++) {
+		if (isTerminal(symbol) || isNonTerminal(symbol)) {
+			hasFirst[symbol] = 1;
+		}
+	}
+	for (int production = 0; production < productionCount(); production++) {
+		hasFirst[productionLhs[production]] = 1;
+		for (const int* symbol = rhsBegin(production); symbol != rhsEnd(production); ++symbol) {
+			hasFirst[*symbol] = 1;
+		}
 	}
 
-	for (const string& nonTerminal : nonTerminals) {
-		firstSets[nonTerminal] = set<string>();
+	//a symbol has "e" in FIRST when it is "e" itself or a production of it is all such symbols
+	//every production counts the symbols in it that are not known to vanish yet
+	vector<char> nullable(n, 0);
+	vector<int> remaining(productionCount());
+	vector<pair<int, int>> occurrencePairs;
+	vector<int> work;
+	for (int production = 0; production < productionCount(); production++) {
+		remaining[production] = rhsLength(production);
+		for (const int* symbol = rhsBegin(production); symbol != rhsEnd(production); ++symbol) {
+			occurrencePairs.push_back({ *symbol, production });
+		}
+		if (remaining[production] == 0 && !nullable[productionLhs[production]]) {
+			nullable[productionLhs[production]] = 1;
+			work.push_back(productionLhs[production]);
+		}
+	}
+	if (isTerminal(epsilon) && !nullable[epsilon]) {
+		nullable[epsilon] = 1;
+		work.push_back(epsilon);
+	}
+	DependencyGraph occurrences(n, occurrencePairs);
+	while (!work.empty()) {
+		int symbol = work.back();
+		work.pop_back();
+		STATS_ADD(NullableSteps, 1);
+		for (int edge = occurrences.edgeStart[symbol]; edge < occurrences.edgeStart[symbol + 1]; edge++) {
+			int production = occurrences.edges[edge];
+			int lhs = productionLhs[production];
+			if (--remaining[production] == 0 && !nullable[lhs]) {
+				nullable[lhs] = 1;
+				work.push_back(lhs);
+			}
+		}
 	}
 
-	bool changed = true;
+	//FIRST(A) takes FIRST of every symbol of a production up to the first one that can't vanish
+	vector<pair<int, int>> dependencies;
+	for (int production = 0; production < productionCount(); production++) {
+		for (const int* symbol = rhsBegin(production); symbol != rhsEnd(production); ++symbol) {
+			dependencies.push_back({ productionLhs[production], *symbol });
+			if (!nullable[*symbol]) {
+				break;
+			}
+		}
+	}
+	for (int symbol = 0; symbol < n; symbol++) {
+		if (isTerminal(symbol) && symbol != epsilon) {
+			firstSets.set(symbol, symbol);
+		}
+	}
+	propagate(DependencyGraph(n, dependencies), firstSets, epsilon);
 
-	while (changed) {
-		changed = false;
+	for (int symbol = 0; symbol < n; symbol++) {
+		if (nullable[symbol]) {
+			firstSets.set(symbol, epsilon);
+		}
+	}
+}
 
-		for (const auto& productionPair : productions) {
-			const string& A = productionPair.first;
-			const auto& productionList = productionPair.second;
+void Grammar::computeFirstOfSuffixes(int endMarker) {
+	//FIRST of the rest of a production from every position, filled right to left
+	//a position whose symbol can't vanish has exactly FIRST of that symbol, only the others get a row here
+	int positions = static_cast<int>(rhsSymbols.size());
+	suffixRow.assign(positions, -1);
+	int rows = 0;
+	for (int position = 0; position < positions; position++) {
+		if (endMarker >= 0 && firstSets.test(rhsSymbols[position], endMarker)) {
+			suffixRow[position] = rows++;
+		}
+	}
+	suffixFirst.reset(rows, symbolCount());
+	suffixVanishes.assign(positions, 0);
+
+	for (int production = 0; production < productionCount(); production++) {
+		int end = rhsStart[production + 1];
+		bool restVanishes = true;
+		for (int position = end - 1; position >= rhsStart[production]; position--) {
+			int row = suffixRow[position];
+			if (row < 0) {
+				restVanishes = false;
+				continue;
+			}
+			suffixFirst.unite(row, firstSets, rhsSymbols[position], endMarker);
+			if (position + 1 < end) {
+				unionFirstOfSuffix(suffixFirst, row, position + 1, endMarker);
+			}
+			suffixVanishes[position] = restVanishes;
+		}
+	}
+}
 
-			for (const auto& production : productionList) {
-				bool epsilonInAll = true;
+void Grammar::unionFirstOfSuffix(BitMatrix& target, int row, int position, int endMarker) const {
+	if (suffixRow[position] >= 0) {
+		target.unite(row, suffixFirst, suffixRow[position]);
+	}
+	else {
+		target.unite(row, firstSets, rhsSymbols[position], endMarker);
+	}
+}
 
-				for (const string& symbol : production) {
-					size_t beforeSize = firstSets[A].size();
+void Grammar::computeFollow() {
+	STATS_PHASE(ComputeFollow);
+	int n = symbolCount();
+	if (static_cast<int>(firstSets.rows()) != n) {
+		computeFirst();
+	}
+	followSets.reset(n, n);
+	hasFollow.assign(n, 0);
 
-					for (const string& symFirst : firstSets[symbol]) {
-						if (symFirst != "e") {
-							firstSets[A].insert(symFirst);
-						}
-					}
+	//"e" stands for the end of the input in FOLLOW, while the rest of a production is only seen as
+	//able to vanish when FIRST has a "$" in it, which no symbol can be called, so -1 unless it is
+	int endMarker = findSymbol("$");
+	computeFirstOfSuffixes(endMarker);
 
-					if (firstSets[A].size() > beforeSize) {
-						changed = true;
-					}
+	if (startSymbol >= 0) {
+		followSets.set(startSymbol, epsilon);
+		hasFollow[startSymbol] = 1;
+	}
 
-					if (firstSets[symbol].find("e") == firstSets[symbol].end()) {
-						epsilonInAll = false;
-						break;
-					}
-				}
+	//FOLLOW(B) gets FIRST of what comes after B right away, and FOLLOW(A) through the graph when that can vanish
+	vector<pair<int, int>> dependencies;
+	for (int production = 0; production < productionCount(); production++) {
+		int A = productionLhs[production];
+		int end = rhsStart[production + 1];
+		for (int position = rhsStart[production]; position < end; position++) {
+			int B = rhsSymbols[position];
+			if (!isNonTerminal(B)) {
+				continue;
+			}
+			hasFollow[B] = 1;
 
-				if (epsilonInAll) {
-					if (firstSets[A].find("e") == firstSets[A].end()) {
-						firstSets[A].insert("e");
-						changed = true;
-					}
-				}
+			if (position + 1 < end) {
+				unionFirstOfSuffix(followSets, B, position + 1, endMarker);
+			}
+			if (position + 1 == end || suffixVanishes[position + 1]) {
+				hasFollow[A] = 1;
+				dependencies.push_back({ B, A });
 			}
 		}
 	}
+	propagate(DependencyGraph(n, dependencies), followSets, -1);
 }
 
-
-void Grammar::computeFollow() {
-	followSets.clear();
-
-	followSets[startSymbol].insert("e");
-
-	bool changed = true;
-
-	while (changed) {
-		changed = false;
-
-		for (const auto& productionPair : productions) {
-			const string& A = productionPair.first;
-			const vector<vector<string>>& productionList = productionPair.second;
-
-			for (const auto& production : productionList) {
-				for (size_t i = 0; i < production.size(); ++i) {
-					const string& B = production[i];
-
-					if (isNonTerminal(B)) {
-						set<string> firstBeta;
-						bool epsilonInBeta = true;
-
-						for (size_t j = i + 1; j < production.size(); ++j) {
-							const string& symbol = production[j];
-							const set<string>& firstSetSymbol = firstSets[symbol];
-
-							for (const string& symFirst : firstSetSymbol) {
-								if (symFirst != "$") {
-									firstBeta.insert(symFirst);
-								}
-							}
-
-							if (firstSetSymbol.find("$") == firstSetSymbol.end()) {
-								epsilonInBeta = false;
-								break;
-							}
-						}
-
-						if (i + 1 < production.size()) {
-							size_t beforeSize = followSets[B].size();
-							bool addedFirst = addToSet(followSets[B], firstBeta);
-							if (addedFirst) {
-								changed = true;
-							}
-
-							if (epsilonInBeta) {
-								size_t beforeSizeFollow = followSets[B].size();
-								bool addedFollow = addToSet(followSets[B], followSets[A]);
-								if (addedFollow) {
-									changed = true;
-								}
-							}
-						}
-						else {
-							size_t beforeSizeFollow = followSets[B].size();
-							bool addedFollow = addToSet(followSets[B], followSets[A]);
-							if (addedFollow) {
-								changed = true;
-							}
-						}
-					}
-				}
+void Grammar::printSymbolSets(const BitMatrix& sets, const vector<char>& present) const {
+	vector<int> sorted = sortedSymbols();
+	for (int symbol : sorted) {
+		if (symbol >= static_cast<int>(present.size()) || !present[symbol]) {
+			continue;
+		}
+		cout << symbolNames[symbol] << ": ";
+		for (int member : sorted) {
+			if (sets.test(symbol, member)) {
+				cout << symbolNames[member] << " ";
 			}
 		}
+		cout << endl;
 	}
 }
 
 void Grammar::printFirstSets() const {
 	cout << "First sets:" << endl;
-	for (const auto& firstSet : firstSets) {
-		cout << firstSet.first << ": ";
-		for (const string& symbol : firstSet.second) {
-			cout << symbol << " ";
-		}
-		cout << endl;
-	}
+	printSymbolSets(firstSets, hasFirst);
 }
 
 void Grammar::printFollowSets() const {
 	cout << "Follow sets:" << endl;
-	for (const auto& followSet : followSets) {
-		cout << followSet.first << ": ";
-		for (const string& symbol : followSet.second) {
-			cout << symbol << " ";
-		}
-		cout << endl;
-	}
+	printSymbolSets(followSets, hasFollow);
 }
@@ -1,28 +1,58 @@
+#pragma once
 #include <string>
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include "BitMatrix.h"
 
+// symbols are interned to dense ids as the grammar is read, the names are only used to read and print
+// productions are kept one after the other: the right hand side of production p is
+// rhsSymbols[rhsStart[p]] .. rhsSymbols[rhsStart[p + 1] - 1]
 class Grammar {
 private:
-    std::set<std::string> nonTerminals;
-    std::set<std::string> terminals;
-    std::string startSymbol;
-    std::map<std::string, std::vector<std::vector<std::string>>> productions;
+    std::vector<std::string> symbolNames;
+    std::unordered_map<std::string, int> symbolIds;
+    std::vector<char> terminalFlags;
+    std::vector<char> nonTerminalFlags;
+    int startSymbol;
+    // "e" marks the empty word, it has an id even when the grammar doesn't list it as a terminal
+    int epsilon;
+
+    std::vector<int> productionLhs;
+    std::vector<int> rhsStart;
+    std::vector<int> rhsSymbols;
+    // productions grouped by left hand side, in the order they were read
+    std::vector<int> lhsStart;
+    std::vector<int> lhsProductions;
+
     bool isTerminal(const std::string& symbol) const;
     bool isNonTerminal(const std::string& symbol) const;
     std::vector<std::string> splitProduction(const std::string& production) const;
+    int internSymbol(const std::string& name);
+    void indexProductions();
+    // ids sorted by name, the order everything is printed in
+    std::vector<int> sortedSymbols() const;
+    void printSymbolSets(const BitMatrix& sets, const std::vector<char>& present) const;
     bool isCFG = true;
 
-    std::map<std::string, std::set<std::string>> firstSets;  // To store First sets
-    std::map<std::string, std::set<std::string>> followSets; // To store Follow sets
+    BitMatrix firstSets;   // row per symbol, bit per symbol
+    BitMatrix followSets;
+    // whether a symbol has a FIRST / FOLLOW entry at all, a symbol can have an empty one
+    std::vector<char> hasFirst;
+    std::vector<char> hasFollow;
+
+    // FIRST of the rest of a production from each rhs position, see computeFirstOfSuffixes
+    std::vector<int> suffixRow;
+    BitMatrix suffixFirst;
+    std::vector<char> suffixVanishes;
+    void computeFirstOfSuffixes(int endMarker);
+    void unionFirstOfSuffix(BitMatrix& target, int row, int position, int endMarker) const;
 
-    // Helper function to add elements to a set and check if it was modified
-    bool addToSet(std::set<std::string>& targetSet, const std::set<std::string>& sourceSet);
 public:
     Grammar();
     bool readFromFile(const std::string& filename);
@@ -30,20 +60,34 @@ public:
     void printTerminals() const;
     void printProductions() const;
     void printProductionsFor(const std::string& nonTerminal) const;
+    void printProduction(int production) const;
     bool checkCFG() const;
 
     // Getters
-    const std::set<std::string>& getNonTerminals() const { return nonTerminals; }
-    const std::set<std::string>& getTerminals() const { return terminals; }
-    const std::string& getStartSymbol() const { return startSymbol; }
-    const std::map<std::string, std::vector<std::vector<std::string>>>& getProductions() const {
-        return productions;
-    }
+    int symbolCount() const { return static_cast<int>(symbolNames.size()); }
+    const std::string& getSymbolName(int symbol) const { return symbolNames[symbol]; }
+    // -1 if there is no such symbol
+    int findSymbol(const std::string& name) const;
+    bool isTerminal(int symbol) const { return terminalFlags[symbol] != 0; }
+    bool isNonTerminal(int symbol) const { return nonTerminalFlags[symbol] != 0; }
+    int getStartSymbol() const { return startSymbol; }
+    int getEpsilon() const { return epsilon; }
+
+    int productionCount() const { return static_cast<int>(productionLhs.size()); }
+    int getProductionLhs(int production) const { return productionLhs[production]; }
+    const int* rhsBegin(int production) const { return rhsSymbols.data() + rhsStart[production]; }
+    const int* rhsEnd(int production) const { return rhsSymbols.data() + rhsStart[production + 1]; }
+    int rhsLength(int production) const { return rhsStart[production + 1] - rhsStart[production]; }
+    // productions with the symbol on the left hand side
+    const int* productionsBegin(int symbol) const { return lhsProductions.data() + lhsStart[symbol]; }
+    const int* productionsEnd(int symbol) const { return lhsProductions.data() + lhsStart[symbol + 1]; }
 
+    const BitMatrix& getFirstSets() const { return firstSets; }
+    const BitMatrix& getFollowSets() const { return followSets; }
 
     void computeFirst();
     void computeFollow();
 
     void printFirstSets() const;
     void printFollowSets() const;
-};
\ No newline at end of file
+};
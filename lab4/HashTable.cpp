@@ -1,114 +1,206 @@
 #include "HashTable.h"
+#include "Statistics.h"
+#include <cstring>
 
-Node::Node(const std::string& key) : val(key), next(nullptr), prev(nullptr) {}
+// the table grows once it is more than 7/8 full
+static const size_t MAX_LOAD_NUMERATOR = 7;
+static const size_t MAX_LOAD_DENOMINATOR = 8;
 
-HashTable::HashTable(int size) {
-    capacity = size;
-    table.resize(size, nullptr);
+HashTable::HashTable(int size) : count(0) {
+    capacity = 16;
+    while (capacity * MAX_LOAD_NUMERATOR < static_cast<size_t>(size) * MAX_LOAD_DENOMINATOR) {
+        capacity *= 2;
+    }
+    table.assign(capacity, { 0, -1 });
 }
 
-int HashTable::hashFunction(const std::string& key) {
-    int hashValue = 0;
-    for (char ch : key) {
-        hashValue += ch;
+uint64_t HashTable::hashFunction(const char* data, size_t length) {
+    const uint64_t k1 = 0x9E3779B97F4A7C15ull;
+    const uint64_t k2 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t hashValue = length * k1;
+
+    // eight bytes at a time, then the tail
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        word *= k2;
+        word ^= word >> 31;
+        hashValue = (hashValue ^ word) * k1;
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < length; i++, shift += 8) {
+        tail |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << shift;
     }
-    return hashValue % capacity;
+    hashValue = (hashValue ^ (tail * k2)) * k1;
+
+    // murmur3 finalizer, so every input bit affects the low bits used for the index
+    hashValue ^= hashValue >> 33;
+    hashValue *= 0xFF51AFD7ED558CCDull;
+    hashValue ^= hashValue >> 33;
+    hashValue *= 0xC4CEB9FE1A85EC53ull;
+    hashValue ^= hashValue >> 33;
+    return hashValue;
 }
 
-void HashTable::insert(const std::string& key) {
-    int index = hashFunction(key);
-    Node* newNode = new Node(key);
+size_t HashTable::probeDistance(size_t index) const {
+    return probeDistanceFor(table[index].hash, index);
+}
 
-    if (table[index] == nullptr) {
-        table[index] = newNode;
-    }
-    else {
-        Node* curr = table[index];
-        while (curr->next != NULL) {
-            curr = curr->next;
+size_t HashTable::probeDistanceFor(uint32_t hash, size_t index) const {
+    return (index - (hash & (capacity - 1))) & (capacity - 1);
+}
+
+int HashTable::find(const char* key, size_t length, uint32_t hash, size_t& index) const {
+    STATS_ADD(SymbolLookups, 1);
+    index = hash & (capacity - 1);
+    for (size_t distance = 0; ; distance++) {
+        const Slot& slot = table[index];
+
+        // robin hood order: once we pass a slot closer to its home than we are, the key is missing
+        if (slot.id < 0 || probeDistance(index) < distance) {
+            STATS_RECORD(ProbeLength, distance);
+            return -1;
+        }
+        if (slot.hash == hash && lengths[slot.id] == length
+            && std::memcmp(arena.data() + offsets[slot.id], key, length) == 0) {
+            STATS_RECORD(ProbeLength, distance);
+            return slot.id;
         }
-        newNode->prev = curr;
-        newNode->next = NULL;
-        curr->next = newNode;
+        index = (index + 1) & (capacity - 1);
     }
 }
 
-void HashTable::insert(int key) {
-    std::string stringKey = std::to_string(key);
-    insert(stringKey);
+void HashTable::place(Slot slot) {
+    placeAt(slot, slot.hash & (capacity - 1));
 }
 
-void HashTable::remove(const std::string& key) {
-    int index = hashFunction(key);
-    Node* curr = table[index];
+void HashTable::placeAt(Slot slot, size_t index) {
+    for (size_t distance = probeDistanceFor(slot.hash, index); ; distance++) {
+        if (table[index].id < 0) {
+            table[index] = slot;
+            return;
+        }
 
-    while (curr != nullptr) {
-        if (curr->val == key) {
-            if (curr->prev != nullptr) {
-                curr->prev->next = curr->next;
-            }
-            else {
-                table[index] = curr->next;
-            }
+        // take the place of an entry that is closer to its home and keep going with that one
+        size_t existing = probeDistance(index);
+        if (existing < distance) {
+            std::swap(slot, table[index]);
+            distance = existing;
+        }
+        index = (index + 1) & (capacity - 1);
+    }
+}
 
-            if (curr->next != nullptr) {
-                curr->next->prev = curr->prev;
-            }
+void HashTable::rehash(size_t newCapacity) {
+    STATS_ADD(Rehashes, 1);
+    std::vector<Slot> old;
+    old.swap(table);
+    capacity = newCapacity;
+    table.assign(capacity, { 0, -1 });
 
-            delete curr;
-            return;
+    for (const Slot& slot : old) {
+        if (slot.id >= 0) {
+            place(slot);
         }
-        curr = curr->next;
     }
-
-    std::cout << "Key '" << key << "' not found in the hash table." << std::endl;
 }
 
-std::pair<int, int> HashTable::searchElem(const std::string& key) {
-    int index = hashFunction(key);
-    Node* curr = table[index];
-    int position = 0;
+int HashTable::findOrInsert(const char* key, size_t length) {
+    uint32_t hash = static_cast<uint32_t>(hashFunction(key, length));
+    size_t index;
+    int id = find(key, length, hash, index);
+    if (id >= 0) {
+        return id;
+    }
 
-    while (curr != nullptr) {
-        if (curr->val == key) {
-            return { index, position };
-        }
-        curr = curr->next;
-        position++;
+    id = static_cast<int>(offsets.size());
+    offsets.push_back(arena.size());
+    lengths.push_back(static_cast<uint32_t>(length));
+    removed.push_back(false);
+    arena.append(key, length);
+    count++;
+    STATS_ADD(SymbolInserts, 1);
+
+    // the probe stopped at the slot the new key belongs to, unless the table has to grow first
+    if (count * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR) {
+        rehash(capacity * 2);
+        place({ hash, id });
     }
+    else {
+        placeAt({ hash, id }, index);
+    }
+    return id;
+}
+
+void HashTable::insert(std::string_view key) {
+    findOrInsert(key);
+}
 
-    return { -1, -1 };
+void HashTable::insert(int key) {
+    std::string stringKey = std::to_string(key);
+    insert(stringKey);
 }
 
+void HashTable::remove(std::string_view key) {
+    uint32_t hash = static_cast<uint32_t>(hashFunction(key.data(), key.size()));
+    size_t index;
+    int id = find(key.data(), key.size(), hash, index);
+
+    if (id < 0) {
+        std::cout << "Key '" << key << "' not found in the hash table." << std::endl;
+        return;
+    }
+
+    // shift the following entries of the cluster back one slot, no tombstones needed
+    size_t next = (index + 1) & (capacity - 1);
+    while (table[next].id >= 0 && probeDistance(next) > 0) {
+        table[index] = table[next];
+        index = next;
+        next = (next + 1) & (capacity - 1);
+    }
+    table[index].id = -1;
 
-bool HashTable::exists(const std::string& key) {
-    int index = hashFunction(key);
-    Node* curr = table[index];
-    int position = 0;
+    // the id is not reused, so positions of the other symbols stay the same
+    removed[id] = true;
+    count--;
+    STATS_ADD(SymbolRemoves, 1);
+}
 
-    while (curr != nullptr) {
-        if (curr->val == key) {
-            return true;
+void HashTable::recordStatistics() const {
+    Statistics::set(Statistics::Gauge::SymbolTableLoadFactor, loadFactor());
+    Statistics::set(Statistics::Gauge::SymbolTableSize, count);
+    Statistics::clear(Statistics::Histogram::Displacement);
+    for (size_t index = 0; index < capacity; index++) {
+        if (table[index].id >= 0) {
+            Statistics::record(Statistics::Histogram::Displacement, probeDistance(index));
         }
-        curr = curr->next;
-        position++;
     }
+}
+
+int HashTable::searchElem(std::string_view key) {
+    uint32_t hash = static_cast<uint32_t>(hashFunction(key.data(), key.size()));
+    size_t index;
+    return find(key.data(), key.size(), hash, index);
+}
+
 
-    return false;
+bool HashTable::exists(std::string_view key) {
+    return searchElem(key) >= 0;
+}
+
+std::string HashTable::getSymbol(int id) const {
+    return arena.substr(offsets[id], lengths[id]);
 }
 
 std::string HashTable::display() {
     std::ostringstream oss; 
 
-    for (int i = 0; i < capacity; i++) {
-        oss << "Bucket " << i << ": "; 
-        Node* curr = table[i];
-
-        while (curr != nullptr) {
-            oss << curr->val << " <-> "; 
-            curr = curr->next; 
+    for (size_t id = 0; id < offsets.size(); id++) {
+        if (removed[id]) {
+            continue;
         }
-        oss << "NULL" << std::endl; 
+        oss << "Position " << id << ": " << getSymbolView(static_cast<int>(id)) << std::endl;
     }
 
     return oss.str(); 
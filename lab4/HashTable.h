@@ -1,36 +1,66 @@
+#pragma once
 #include <string>
+#include <string_view>
 #include <vector>
-#include <string>
+#include <cstdint>
 #include <iostream>
-#include <sstream> 
-
-
-class Node {
-public:
-    std::string val;
-    Node* next;
-    Node* prev;
-    Node(const std::string& key);
-};
-
+#include <sstream>
 
 
+// open addressing symbol table with robin hood probing
+// every symbol gets a position id in the order it was inserted, the id never changes when the table grows
+// the symbols themselves are kept one after the other in a single arena
 class HashTable {
 private:
-    std::vector<Node*> table;
-    int capacity;
+    struct Slot {
+        uint32_t hash;
+        int32_t id;     // -1 for an empty slot
+    };
 
-    int hashFunction(const std::string& key);
+    std::vector<Slot> table;
+    size_t capacity;
+    int count;
+
+    std::string arena;
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<bool> removed;
+
+    size_t probeDistance(size_t index) const;
+    size_t probeDistanceFor(uint32_t hash, size_t index) const;
+    int find(const char* key, size_t length, uint32_t hash, size_t& index) const;
+    void place(Slot slot);
+    void placeAt(Slot slot, size_t index);
+    void rehash(size_t newCapacity);
 
 public:
     HashTable(int size);
 
-    void insert(const std::string& key);
+    // also spreads the symbols of ConcurrentSymbolTable, so both tables hash the same way
+    static uint64_t hashFunction(const char* data, size_t length);
+
+    // position id of the key, the key is inserted first if it is not in the table yet
+    // this takes a single probe sequence, unlike exists + insert + searchElem
+    int findOrInsert(const char* key, size_t length);
+    int findOrInsert(std::string_view key) { return findOrInsert(key.data(), key.size()); }
+
+    // inserting a key that is already in the table does nothing
+    void insert(std::string_view key);
     void insert(int key);
-    void remove(const std::string& key);
-    std::pair<int, int> searchElem(const std::string& key);
+    void remove(std::string_view key);
+    // position id of the key, -1 if it is not in the table
+    int searchElem(std::string_view key);
     std::string display();
-    bool exists(const std::string& key);
+    bool exists(std::string_view key);
 
-};
+    std::string getSymbol(int id) const;
+    // the text in the arena, valid until the next insert
+    std::string_view getSymbolView(int id) const { return std::string_view(arena.data() + offsets[id], lengths[id]); }
+    const char* getSymbolData(int id) const { return arena.data() + offsets[id]; }
+    size_t getSymbolLength(int id) const { return lengths[id]; }
+    int size() const { return count; }
+    double loadFactor() const { return static_cast<double>(count) / capacity; }
+    // load factor, size and how far every symbol sits from its home slot, for the statistics report
+    void recordStatistics() const;
 
+};
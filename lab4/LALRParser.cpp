@@ -0,0 +1,507 @@
+#include "LALRParser.h"
+#include "DependencyGraph.h"
+#include "Statistics.h"
+using namespace std;
+
+
+// kernels are looked up by their items, so a state reached again is not built twice
+struct KernelHash {
+	size_t operator()(const vector<pair<int, int>>& items) const {
+		size_t hash = items.size();
+		for (const auto& item : items) {
+			hash = hash * 1000003 ^ (static_cast<size_t>(item.first) * 31 + item.second);
+		}
+		return hash;
+	}
+};
+
+// overlaps the rows in one array, the entry of row r for column c goes to slot base[r] + c and check holds c there
+// rows with the same entries share their slots, any other two rows get different bases so check tells them apart
+// the rows with the most entries are placed first, each one at the first base where all of its slots are free,
+// a row without entries gets base -1
+// the entries of a row have to be sorted by column
+static void packRows(const vector<vector<pair<int, int>>>& rows, vector<int>& base, vector<int>& check, vector<int>& value)
+{
+	vector<int> order(rows.size());
+	for (size_t row = 0; row < rows.size(); row++) {
+		order[row] = static_cast<int>(row);
+	}
+	sort(order.begin(), order.end(), [&](int a, int b) {
+		return rows[a].size() != rows[b].size() ? rows[a].size() > rows[b].size() : rows[a] < rows[b];
+	});
+
+	base.assign(rows.size(), -1);
+	check.clear();
+	value.clear();
+	vector<char> baseUsed;
+	//nextFree[slot] is the slot itself when it is free, otherwise a slot further on to look from,
+	//so the search for a place skips the full part of the array
+	vector<size_t> nextFree;
+	auto findFree = [&](size_t slot) {
+		while (slot < nextFree.size() && nextFree[slot] != slot) {
+			size_t next = nextFree[slot];
+			if (next < nextFree.size()) {
+				nextFree[slot] = nextFree[next];
+			}
+			slot = next;
+		}
+		return slot;
+	};
+
+	for (size_t i = 0; i < order.size(); i++) {
+		const vector<pair<int, int>>& entries = rows[order[i]];
+		if (entries.empty()) {
+			continue;
+		}
+		if (i > 0 && rows[order[i - 1]] == entries) {
+			base[order[i]] = base[order[i - 1]];
+			continue;
+		}
+
+		//the first entry goes to a free slot, the base is good if the others land on free slots too
+		size_t candidate;
+		for (size_t firstSlot = findFree(entries[0].first); ; firstSlot = findFree(firstSlot + 1)) {
+			candidate = firstSlot - entries[0].first;
+			bool fits = candidate >= baseUsed.size() || !baseUsed[candidate];
+			for (size_t entry = 1; fits && entry < entries.size(); entry++) {
+				size_t slot = candidate + entries[entry].first;
+				fits = slot >= check.size() || check[slot] < 0;
+			}
+			if (fits) {
+				break;
+			}
+		}
+
+		base[order[i]] = static_cast<int>(candidate);
+		if (candidate >= baseUsed.size()) {
+			baseUsed.resize(candidate + 1, 0);
+		}
+		baseUsed[candidate] = 1;
+		for (const auto& entry : entries) {
+			size_t slot = candidate + entry.first;
+			while (slot >= check.size()) {
+				nextFree.push_back(check.size());
+				check.push_back(-1);
+				value.push_back(0);
+			}
+			check[slot] = entry.first;
+			value[slot] = entry.second;
+			nextFree[slot] = slot + 1;
+		}
+	}
+}
+
+// value of the row at the column in a packed table, the default if the row has no entry there
+static int unpack(const vector<int>& base, const vector<int>& check, const vector<int>& value, int row, int column, int defaultValue)
+{
+	if (base[row] < 0) {
+		return defaultValue;
+	}
+	size_t slot = static_cast<size_t>(base[row]) + column;
+	return slot < check.size() && check[slot] == column ? value[slot] : defaultValue;
+}
+
+
+LALRParser::LALRParser(const Grammar& grammar)
+	: grammar(grammar), acceptProduction(grammar.productionCount()), endColumn(0), nonTerminalTransitions(0)
+{
+	STATS_PHASE(BuildLALR);
+	readProductions();
+	buildStates();
+	computeLookaheads();
+	fillTables();
+}
+
+void LALRParser::readProductions()
+{
+	const BitMatrix& first = grammar.getFirstSets();
+	int n = grammar.symbolCount();
+	int epsilon = grammar.getEpsilon();
+
+	rhsStart.assign(1, 0);
+	for (int production = 0; production < acceptProduction; production++) {
+		productionLhs.push_back(grammar.getProductionLhs(production));
+		for (const int* symbol = grammar.rhsBegin(production); symbol != grammar.rhsEnd(production); ++symbol) {
+			if (*symbol != epsilon) {
+				rhsSymbols.push_back(*symbol);
+			}
+		}
+		rhsStart.push_back(static_cast<int>(rhsSymbols.size()));
+	}
+	//start' -> start, its left hand side is a symbol past the grammar's
+	productionLhs.push_back(n);
+	rhsSymbols.push_back(grammar.getStartSymbol());
+	rhsStart.push_back(static_cast<int>(rhsSymbols.size()));
+
+	nullable.assign(n, 0);
+	columnOf.assign(n, -1);
+	rowOf.assign(n, -1);
+	int rows = 0;
+	for (int symbol = 0; symbol < n; symbol++) {
+		nullable[symbol] = first.test(symbol, epsilon);
+		if (grammar.isNonTerminal(symbol)) {
+			rowOf[symbol] = rows++;
+		}
+		else if (grammar.isTerminal(symbol) && symbol != epsilon) {
+			columnOf[symbol] = static_cast<int>(columnTerminals.size());
+			columnTerminals.push_back(symbol);
+		}
+	}
+	endColumn = static_cast<int>(columnTerminals.size());
+	columnTerminals.push_back(-1);
+}
+
+void LALRParser::buildStates()
+{
+	unordered_map<vector<pair<int, int>>, int, KernelHash> stateOf;
+	vector<pair<int, int>> kernel = { { acceptProduction, 0 } };
+	stateOf.emplace(kernel, 0);
+	kernelStart = { 0, 1 };
+	kernelItems = kernel;
+	transitionStart.assign(1, 0);
+	reductionStart.assign(1, 0);
+
+	//the last state whose closure has the productions of a nonterminal, so they are added once per state
+	vector<int> addedIn(grammar.symbolCount(), -1);
+	vector<pair<int, int>> closure;
+	vector<pair<int, pair<int, int>>> moves;   // symbol read, item after it
+
+	for (int state = 0; state < stateCount(); state++) {
+		closure.assign(kernelItems.begin() + kernelStart[state], kernelItems.begin() + kernelStart[state + 1]);
+		for (size_t i = 0; i < closure.size(); i++) {
+			int production = closure[i].first;
+			int read = closure[i].second;
+			if (read == rhsLength(production)) {
+				reductionProductions.push_back(production);
+				continue;
+			}
+
+			int symbol = rhsSymbols[rhsStart[production] + read];
+			moves.push_back({ symbol, { production, read + 1 } });
+			if (rowOf[symbol] >= 0 && addedIn[symbol] != state) {
+				addedIn[symbol] = state;
+				for (const int* next = grammar.productionsBegin(symbol); next != grammar.productionsEnd(symbol); ++next) {
+					closure.push_back({ *next, 0 });
+				}
+			}
+		}
+		reductionStart.push_back(static_cast<int>(reductionProductions.size()));
+
+		//the items that read the same symbol are the kernel of the state it goes to
+		sort(moves.begin(), moves.end());
+		for (size_t begin = 0, end; begin < moves.size(); begin = end) {
+			int symbol = moves[begin].first;
+			kernel.clear();
+			for (end = begin; end < moves.size() && moves[end].first == symbol; end++) {
+				kernel.push_back(moves[end].second);
+			}
+
+			auto found = stateOf.emplace(kernel, stateCount());
+			if (found.second) {
+				kernelItems.insert(kernelItems.end(), kernel.begin(), kernel.end());
+				kernelStart.push_back(static_cast<int>(kernelItems.size()));
+			}
+			transitionSymbols.push_back(symbol);
+			transitionTargets.push_back(found.first->second);
+		}
+		transitionStart.push_back(static_cast<int>(transitionSymbols.size()));
+		moves.clear();
+	}
+}
+
+int LALRParser::findTransition(int state, int symbol) const
+{
+	auto begin = transitionSymbols.begin() + transitionStart[state];
+	auto end = transitionSymbols.begin() + transitionStart[state + 1];
+	auto found = lower_bound(begin, end, symbol);
+	return found != end && *found == symbol ? static_cast<int>(found - transitionSymbols.begin()) : -1;
+}
+
+void LALRParser::computeLookaheads()
+{
+	//the relations are between nonterminal transitions, they get numbers of their own
+	vector<int> nodeOf(transitionSymbols.size(), -1);
+	vector<int> nodeState;
+	vector<int> nodeTransition;
+	for (int state = 0; state < stateCount(); state++) {
+		for (int t = transitionStart[state]; t < transitionStart[state + 1]; t++) {
+			if (rowOf[transitionSymbols[t]] >= 0) {
+				nodeOf[t] = static_cast<int>(nodeTransition.size());
+				nodeState.push_back(state);
+				nodeTransition.push_back(t);
+			}
+		}
+	}
+	nonTerminalTransitions = static_cast<int>(nodeTransition.size());
+
+	//Read: the terminals that can be shifted right after a transition, directly or after nullable nonterminals
+	BitMatrix follow(nonTerminalTransitions, columnTerminals.size());
+	vector<pair<int, int>> reads;
+	for (int node = 0; node < nonTerminalTransitions; node++) {
+		int target = transitionTargets[nodeTransition[node]];
+		for (int t = transitionStart[target]; t < transitionStart[target + 1]; t++) {
+			int symbol = transitionSymbols[t];
+			if (columnOf[symbol] >= 0) {
+				follow.set(node, columnOf[symbol]);
+			}
+			else if (rowOf[symbol] >= 0 && nullable[symbol]) {
+				reads.push_back({ node, nodeOf[t] });
+			}
+		}
+	}
+	int startTransition = findTransition(0, grammar.getStartSymbol());
+	if (startTransition >= 0) {
+		follow.set(nodeOf[startTransition], endColumn);
+	}
+	propagate(DependencyGraph(nonTerminalTransitions, reads), follow);
+
+	//includes: (p, A) takes the Follow of (p', B) when B -> x A y with y nullable and p' reading x gets to p
+	//lookback: the reduction by B -> w in the state p' gets to by reading w takes the Follow of (p', B)
+	vector<pair<int, int>> includes;
+	vector<pair<int, int>> lookback;
+	vector<int> path;
+	for (int node = 0; node < nonTerminalTransitions; node++) {
+		int from = nodeState[node];
+		int lhs = transitionSymbols[nodeTransition[node]];
+		for (const int* production = grammar.productionsBegin(lhs); production != grammar.productionsEnd(lhs); ++production) {
+			const int* rhs = rhsSymbols.data() + rhsStart[*production];
+			int length = rhsLength(*production);
+
+			path.clear();
+			int state = from;
+			for (int i = 0; i < length; i++) {
+				path.push_back(findTransition(state, rhs[i]));
+				state = transitionTargets[path.back()];
+			}
+			for (int i = length - 1; i >= 0; i--) {
+				if (rowOf[rhs[i]] >= 0) {
+					includes.push_back({ nodeOf[path[i]], node });
+				}
+				if (!nullable[rhs[i]]) {
+					break;
+				}
+			}
+			for (int reduction = reductionStart[state]; reduction < reductionStart[state + 1]; reduction++) {
+				if (reductionProductions[reduction] == *production) {
+					lookback.push_back({ reduction, node });
+					break;
+				}
+			}
+		}
+	}
+	propagate(DependencyGraph(nonTerminalTransitions, includes), follow);
+
+	lookaheads.reset(reductionProductions.size(), columnTerminals.size());
+	for (const auto& edge : lookback) {
+		lookaheads.unite(edge.first, follow, edge.second);
+	}
+}
+
+void LALRParser::fillTables()
+{
+	int states = stateCount();
+	int columns = static_cast<int>(columnTerminals.size());
+	vector<int> row(columns, 0);
+	vector<int> touched;
+	int gotoRowCount = 0;
+	for (int symbol = 0; symbol < grammar.symbolCount(); symbol++) {
+		gotoRowCount += rowOf[symbol] >= 0;
+	}
+	vector<vector<pair<int, int>>> actionRows(states);
+	vector<vector<pair<int, int>>> gotoRows(gotoRowCount);
+	defaultReduction.assign(states, 0);
+	defaultGoto.assign(gotoRowCount, -1);
+
+	for (int state = 0; state < states; state++) {
+		int current = state;
+		//shifts are greater than reductions and reductions by earlier productions greater than later ones,
+		//so the action kept in a conflict is always the larger one
+		auto addAction = [&](int column, int action) {
+			int& entry = row[column];
+			if (entry == 0) {
+				entry = action;
+				touched.push_back(column);
+			}
+			else if (entry != action) {
+				conflicts.push_back({ current, columnTerminals[column], max(entry, action), min(entry, action) });
+				entry = max(entry, action);
+			}
+		};
+
+		for (int t = transitionStart[state]; t < transitionStart[state + 1]; t++) {
+			int symbol = transitionSymbols[t];
+			if (rowOf[symbol] >= 0) {
+				gotoRows[rowOf[symbol]].push_back({ state, transitionTargets[t] });
+			}
+			else if (columnOf[symbol] >= 0) {
+				addAction(columnOf[symbol], shiftAction(transitionTargets[t]));
+			}
+		}
+		for (int reduction = reductionStart[state]; reduction < reductionStart[state + 1]; reduction++) {
+			int production = reductionProductions[reduction];
+			if (production == acceptProduction) {
+				addAction(endColumn, reduceAction(production));
+				continue;
+			}
+			lookaheads.forEach(reduction, [&](size_t column) {
+				addAction(static_cast<int>(column), reduceAction(production));
+			});
+		}
+
+		//the most common reduction becomes the default, accepting never does since it must see the end
+		int bestCount = 0;
+		for (int reduction = reductionStart[state]; reduction < reductionStart[state + 1]; reduction++) {
+			int action = reduceAction(reductionProductions[reduction]);
+			if (reductionProductions[reduction] == acceptProduction) {
+				continue;
+			}
+			int count = 0;
+			for (int column : touched) {
+				count += row[column] == action;
+			}
+			if (count > bestCount || (count == bestCount && count > 0 && action > defaultReduction[state])) {
+				bestCount = count;
+				defaultReduction[state] = action;
+			}
+		}
+
+		sort(touched.begin(), touched.end());
+		for (int column : touched) {
+			if (row[column] != defaultReduction[state]) {
+				actionRows[state].push_back({ column, row[column] });
+			}
+			row[column] = 0;
+		}
+		touched.clear();
+	}
+
+	//the most common target of a nonterminal becomes its default
+	vector<int> targetCount(states, 0);
+	for (int gotoRow = 0; gotoRow < gotoRowCount; gotoRow++) {
+		vector<pair<int, int>>& entries = gotoRows[gotoRow];
+		int bestCount = 0;
+		for (const auto& entry : entries) {
+			int count = ++targetCount[entry.second];
+			if (count > bestCount) {
+				bestCount = count;
+				defaultGoto[gotoRow] = entry.second;
+			}
+		}
+		for (const auto& entry : entries) {
+			targetCount[entry.second] = 0;
+		}
+		entries.erase(remove_if(entries.begin(), entries.end(),
+			[&](const pair<int, int>& entry) { return entry.second == defaultGoto[gotoRow]; }), entries.end());
+	}
+
+	packRows(actionRows, actionBase, actionCheck, actionValue);
+	packRows(gotoRows, gotoBase, gotoCheck, gotoValue);
+}
+
+int LALRParser::getAction(int state, int terminal) const
+{
+	int column = terminal < 0 ? endColumn : columnOf[terminal];
+	if (column < 0) {
+		return 0;
+	}
+	return unpack(actionBase, actionCheck, actionValue, state, column, defaultReduction[state]);
+}
+
+int LALRParser::getGoto(int state, int nonTerminal) const
+{
+	int gotoRow = rowOf[nonTerminal];
+	return unpack(gotoBase, gotoCheck, gotoValue, gotoRow, state, defaultGoto[gotoRow]);
+}
+
+vector<int> LALRParser::parse(const ProgramInternalForm& pif, const TokenMapping& mapping) const
+{
+	STATS_PHASE(Parse);
+	TerminalReader reader(pif, mapping);
+	vector<int> states = { 0 };
+	vector<int> reductions;
+
+	for (;;) {
+		int state = states.back();
+		int action = getAction(state, reader.current());
+		if (action > 0) {
+			states.push_back(action - 1);
+			reader.advance();
+			continue;
+		}
+		if (action == 0) {
+			throw reader.unexpected(expectedIn(state));
+		}
+
+		int production = -action - 1;
+		if (production == acceptProduction) {
+			return reductions;
+		}
+		reductions.push_back(production);
+		states.resize(states.size() - rhsLength(production));
+		states.push_back(getGoto(states.back(), productionLhs[production]));
+	}
+}
+
+string LALRParser::terminalName(int terminal) const
+{
+	return terminal < 0 ? "end of program" : grammar.getSymbolName(terminal);
+}
+
+string LALRParser::expectedIn(int state) const
+{
+	string expected;
+	for (int terminal : columnTerminals) {
+		if (getAction(state, terminal) != 0) {
+			expected += (expected.empty() ? "" : ", ") + terminalName(terminal);
+		}
+	}
+	return expected;
+}
+
+void LALRParser::printAction(int action) const
+{
+	if (action > 0) {
+		cout << "shift to state " << action - 1 << endl;
+	}
+	else if (-action - 1 == acceptProduction) {
+		cout << "accept" << endl;
+	}
+	else {
+		cout << "reduce by ";
+		grammar.printProduction(-action - 1);
+	}
+}
+
+void LALRParser::printConflicts() const
+{
+	if (conflicts.empty()) {
+		cout << "The grammar is LALR(1)" << endl;
+		return;
+	}
+
+	cout << "LALR(1) conflicts: " << conflicts.size() << endl;
+	for (const Conflict& conflict : conflicts) {
+		cout << "State " << conflict.state << " on " << terminalName(conflict.terminal) << ": "
+			<< (conflict.chosen > 0 ? "shift/reduce" : "reduce/reduce") << endl;
+		cout << "    kept     ";
+		printAction(conflict.chosen);
+		cout << "    rejected ";
+		printAction(conflict.rejected);
+	}
+}
+
+void LALRParser::printStatistics() const
+{
+	long long states = stateCount();
+	long long dense = states * (columnTerminals.size() + defaultGoto.size());
+	long long compressed = 2 * (actionCheck.size() + gotoCheck.size()) + 2 * states + 2 * defaultGoto.size();
+	cout << "States: " << states << ", nonterminal transitions: " << nonTerminalTransitions << endl;
+	cout << "Table entries: " << dense << " dense, " << compressed << " compressed" << endl;
+}
+
+void LALRParser::printDerivation(const vector<int>& reductions) const
+{
+	for (auto production = reductions.rbegin(); production != reductions.rend(); ++production) {
+		grammar.printProduction(*production);
+	}
+}
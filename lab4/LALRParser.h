@@ -0,0 +1,103 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Grammar.h"
+#include "BitMatrix.h"
+#include "TokenMapping.h"
+
+// LALR(1) tables of a grammar and the shift-reduce parser that runs on them
+// the LR(0) states come first, their lookaheads are then found with DeRemer and Pennello's relations:
+// reads and includes over the nonterminal transitions, each one solved with propagate, and lookback
+// to take the result to the reductions, so no LR(1) states are ever built
+//
+// both tables are compressed: every state reduces by its most common production on the terminals it has
+// no other action for, every nonterminal goes to its most common state, and what is left of the rows
+// is overlapped in one array (row displacement), with check saying which column a slot was filled for
+class LALRParser {
+public:
+    // actions as the table keeps them: 0 is an error, s + 1 shifts to state s, -(p + 1) reduces by production p
+    // reducing by the production after the last one of the grammar (start' -> start) accepts
+    static int shiftAction(int state) { return state + 1; }
+    static int reduceAction(int production) { return -(production + 1); }
+
+    // a cell with more than one action, shifts win over reductions and earlier productions over later ones
+    struct Conflict {
+        int state;
+        int terminal;       // -1 for the end of the program
+        int chosen;
+        int rejected;
+    };
+
+    // the grammar has to have its FIRST sets computed, and has to outlive the parser
+    explicit LALRParser(const Grammar& grammar);
+
+    bool isLALR1() const { return conflicts.empty(); }
+    const std::vector<Conflict>& getConflicts() const { return conflicts; }
+    void printConflicts() const;
+    // states, transitions and the size of the tables before and after compression
+    void printStatistics() const;
+
+    int stateCount() const { return static_cast<int>(kernelStart.size()) - 1; }
+    // action of the state on the terminal (-1 for the end of the program)
+    int getAction(int state, int terminal) const;
+    // state reached from the state after a reduction to the nonterminal
+    int getGoto(int state, int nonTerminal) const;
+
+    // the productions in the order they were reduced, the rightmost derivation of the program backwards
+    // throws a SyntaxException at the first token that doesn't fit the grammar
+    std::vector<int> parse(const ProgramInternalForm& pif, const TokenMapping& mapping) const;
+    // the rightmost derivation, from the start symbol down
+    void printDerivation(const std::vector<int>& reductions) const;
+
+private:
+    const Grammar& grammar;
+    int acceptProduction;               // start' -> start, not one of the grammar's
+
+    // right hand sides without "e", the accepting production last
+    std::vector<int> productionLhs;
+    std::vector<int> rhsStart;
+    std::vector<int> rhsSymbols;
+    std::vector<char> nullable;
+
+    std::vector<int> columnOf;          // terminal -> action column, -1 if it is not a terminal
+    std::vector<int> columnTerminals;   // action column -> terminal, -1 for the end column
+    int endColumn;
+    std::vector<int> rowOf;             // nonterminal -> goto row, -1 if it is not a nonterminal
+
+    // LR(0) states by their kernel items, an item is the production and how much of it was read
+    std::vector<int> kernelStart;
+    std::vector<std::pair<int, int>> kernelItems;
+    // transitions of each state sorted by symbol
+    std::vector<int> transitionStart;
+    std::vector<int> transitionSymbols;
+    std::vector<int> transitionTargets;
+    // completed items of each state, with the lookahead of each one
+    std::vector<int> reductionStart;
+    std::vector<int> reductionProductions;
+    BitMatrix lookaheads;               // row per reduction, bit per action column
+
+    // compressed tables
+    std::vector<int> defaultReduction;  // by state, 0 if the state has none
+    std::vector<int> actionBase;
+    std::vector<int> actionCheck;
+    std::vector<int> actionValue;
+    std::vector<int> defaultGoto;       // by goto row
+    std::vector<int> gotoBase;
+    std::vector<int> gotoCheck;
+    std::vector<int> gotoValue;
+
+    std::vector<Conflict> conflicts;
+    int nonTerminalTransitions;
+
+    void readProductions();
+    void buildStates();
+    void computeLookaheads();
+    void fillTables();
+    // index of the transition of the state on the symbol, -1 if there is none
+    int findTransition(int state, int symbol) const;
+    int rhsLength(int production) const { return rhsStart[production + 1] - rhsStart[production]; }
+
+    std::string terminalName(int terminal) const;
+    std::string expectedIn(int state) const;
+    void printAction(int action) const;
+};
@@ -0,0 +1,210 @@
+#include "LL1Parser.h"
+#include "DependencyGraph.h"
+#include "Statistics.h"
+using namespace std;
+
+
+LL1Parser::LL1Parser(const Grammar& grammar) : grammar(grammar), endColumn(0)
+{
+	STATS_PHASE(BuildLL1);
+	int n = grammar.symbolCount();
+	int epsilon = grammar.getEpsilon();
+	rowOf.assign(n, -1);
+	columnOf.assign(n, -1);
+
+	int rows = 0;
+	for (int symbol = 0; symbol < n; symbol++) {
+		if (grammar.isNonTerminal(symbol)) {
+			rowOf[symbol] = rows++;
+		}
+		else if (grammar.isTerminal(symbol) && symbol != epsilon) {
+			columnOf[symbol] = static_cast<int>(columnTerminals.size());
+			columnTerminals.push_back(symbol);
+		}
+	}
+	endColumn = static_cast<int>(columnTerminals.size());
+	columnTerminals.push_back(-1);
+	table.assign(static_cast<size_t>(rows) * columnTerminals.size(), -1);
+
+	computeFollow();
+	fillTable();
+}
+
+void LL1Parser::computeFollow()
+{
+	const BitMatrix& first = grammar.getFirstSets();
+	int n = grammar.symbolCount();
+	int epsilon = grammar.getEpsilon();
+	follow.reset(n, n);
+	if (grammar.getStartSymbol() >= 0) {
+		follow.set(grammar.getStartSymbol(), epsilon);
+	}
+
+	//right to left over every production, rest holds FIRST of what comes after the current symbol
+	BitMatrix rest(1, n);
+	vector<pair<int, int>> dependencies;
+	for (int production = 0; production < grammar.productionCount(); production++) {
+		int A = grammar.getProductionLhs(production);
+		rest.clearRow(0);
+		bool restVanishes = true;
+
+		for (const int* symbol = grammar.rhsEnd(production); symbol != grammar.rhsBegin(production); ) {
+			--symbol;
+			if (grammar.isNonTerminal(*symbol)) {
+				follow.unite(*symbol, rest, 0);
+				if (restVanishes) {
+					dependencies.push_back({ *symbol, A });
+				}
+			}
+
+			if (!first.test(*symbol, epsilon)) {
+				rest.clearRow(0);
+				restVanishes = false;
+			}
+			rest.unite(0, first, *symbol, epsilon);
+		}
+	}
+	propagate(DependencyGraph(n, dependencies), follow);
+}
+
+void LL1Parser::fillTable()
+{
+	const BitMatrix& first = grammar.getFirstSets();
+	int n = grammar.symbolCount();
+	int epsilon = grammar.getEpsilon();
+	int columns = static_cast<int>(columnTerminals.size());
+
+	BitMatrix predict(1, n);
+	for (int production = 0; production < grammar.productionCount(); production++) {
+		int A = grammar.getProductionLhs(production);
+		if (rowOf[A] < 0) {
+			continue;
+		}
+
+		//FIRST of the right hand side, and FOLLOW of A when all of it can vanish
+		predict.clearRow(0);
+		bool vanishes = true;
+		for (const int* symbol = grammar.rhsBegin(production); symbol != grammar.rhsEnd(production); ++symbol) {
+			predict.unite(0, first, *symbol, epsilon);
+			if (!first.test(*symbol, epsilon)) {
+				vanishes = false;
+				break;
+			}
+		}
+		if (vanishes) {
+			predict.unite(0, follow, A);
+		}
+
+		predict.forEach(0, [&](size_t terminal) {
+			int column = static_cast<int>(terminal) == epsilon ? endColumn : columnOf[terminal];
+			if (column < 0) {
+				return;
+			}
+			int& entry = table[static_cast<size_t>(rowOf[A]) * columns + column];
+			if (entry < 0) {
+				entry = production;
+			}
+			else if (entry != production) {
+				conflicts.push_back({ A, columnTerminals[column], entry, production });
+			}
+		});
+	}
+}
+
+int LL1Parser::getProduction(int nonTerminal, int terminal) const
+{
+	int column = terminal < 0 ? endColumn : columnOf[terminal];
+	if (rowOf[nonTerminal] < 0 || column < 0) {
+		return -1;
+	}
+	return table[static_cast<size_t>(rowOf[nonTerminal]) * columnTerminals.size() + column];
+}
+
+string LL1Parser::terminalName(int terminal) const
+{
+	return terminal < 0 ? "end of program" : grammar.getSymbolName(terminal);
+}
+
+void LL1Parser::printConflicts() const
+{
+	if (conflicts.empty()) {
+		cout << "The grammar is LL(1)" << endl;
+		return;
+	}
+
+	cout << "LL(1) conflicts: " << conflicts.size() << endl;
+	for (const Conflict& conflict : conflicts) {
+		cout << grammar.getSymbolName(conflict.nonTerminal) << " on " << terminalName(conflict.terminal) << ":" << endl;
+		cout << "    kept     ";
+		grammar.printProduction(conflict.chosen);
+		cout << "    rejected ";
+		grammar.printProduction(conflict.rejected);
+	}
+}
+
+string LL1Parser::expectedAfter(int symbol) const
+{
+	if (symbol < 0) {
+		return "end of program";
+	}
+	if (rowOf[symbol] < 0) {
+		return grammar.getSymbolName(symbol);
+	}
+
+	string expected;
+	for (int column = 0; column < static_cast<int>(columnTerminals.size()); column++) {
+		if (table[static_cast<size_t>(rowOf[symbol]) * columnTerminals.size() + column] >= 0) {
+			expected += (expected.empty() ? "" : ", ") + terminalName(columnTerminals[column]);
+		}
+	}
+	return expected;
+}
+
+vector<int> LL1Parser::parse(const ProgramInternalForm& pif, const TokenMapping& mapping) const
+{
+	STATS_PHASE(Parse);
+	int epsilon = grammar.getEpsilon();
+	TerminalReader reader(pif, mapping);
+	vector<int> derivation;
+	vector<int> stack = { -1, grammar.getStartSymbol() };
+
+	for (;;) {
+		int top = stack.back();
+		int lookahead = reader.current();
+		if (top < 0) {
+			if (lookahead >= 0) {
+				throw reader.unexpected(expectedAfter(-1));
+			}
+			return derivation;
+		}
+
+		if (rowOf[top] < 0) {
+			if (top != lookahead) {
+				throw reader.unexpected(expectedAfter(top));
+			}
+			stack.pop_back();
+			reader.advance();
+			continue;
+		}
+
+		int production = getProduction(top, lookahead);
+		if (production < 0) {
+			throw reader.unexpected(expectedAfter(top));
+		}
+		derivation.push_back(production);
+		stack.pop_back();
+		for (const int* symbol = grammar.rhsEnd(production); symbol != grammar.rhsBegin(production); ) {
+			--symbol;
+			if (*symbol != epsilon) {
+				stack.push_back(*symbol);
+			}
+		}
+	}
+}
+
+void LL1Parser::printDerivation(const vector<int>& productions) const
+{
+	for (int production : productions) {
+		grammar.printProduction(production);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Grammar.h"
+#include "BitMatrix.h"
+#include "TokenMapping.h"
+
+// LL(1) parse table of a grammar and the predictive parser that runs on it
+// the table is a dense nonterminal x terminal array of production numbers, with one more column
+// for the end of the program, the parser keeps its own stack and reads the token codes of a PIF
+class LL1Parser {
+public:
+    // a cell of the table more than one production was predicted for, the first one stays in the table
+    struct Conflict {
+        int nonTerminal;
+        int terminal;       // -1 for the end of the program
+        int chosen;
+        int rejected;
+    };
+
+    // the grammar has to have its FIRST sets computed, and has to outlive the parser
+    explicit LL1Parser(const Grammar& grammar);
+
+    bool isLL1() const { return conflicts.empty(); }
+    const std::vector<Conflict>& getConflicts() const { return conflicts; }
+    void printConflicts() const;
+
+    // production to expand the nonterminal with when the next terminal is the given one (-1 for the end), -1 if none
+    int getProduction(int nonTerminal, int terminal) const;
+
+    // productions of the leftmost derivation of the program, in the order they were applied
+    // throws a SyntaxException at the first token that doesn't fit the grammar
+    std::vector<int> parse(const ProgramInternalForm& pif, const TokenMapping& mapping) const;
+    void printDerivation(const std::vector<int>& productions) const;
+
+private:
+    const Grammar& grammar;
+    std::vector<int> rowOf;             // symbol -> row, -1 if it is not a nonterminal
+    std::vector<int> columnOf;          // symbol -> column, -1 if it is not a terminal
+    std::vector<int> columnTerminals;   // column -> terminal, -1 for the end column
+    int endColumn;
+    std::vector<int> table;             // rows x columns, -1 for an error entry
+    std::vector<Conflict> conflicts;
+
+    // FOLLOW as the parser needs it: the rest of a production can vanish, "e" marks the end of the program
+    BitMatrix follow;
+
+    void computeFollow();
+    void fillTable();
+    std::string expectedAfter(int symbol) const;
+    std::string terminalName(int terminal) const;
+};
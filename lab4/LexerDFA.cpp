@@ -0,0 +1,73 @@
+#include "LexerDFA.h"
+#include "Statistics.h"
+#include <iostream>
+using namespace std;
+
+LexerDFA::LexerDFA() : determinizedStateCount(0)
+{
+	start = nfa.addState();
+}
+
+void LexerDFA::addKeyword(const string& text, int code)
+{
+	nfa.addEpsilon(start, nfa.addLiteral(text, code, KEYWORD_PRIORITY));
+}
+
+void LexerDFA::addAutomaton(const FA& fa, int code)
+{
+	const DFATable& dfa = fa.getTable();
+	if (dfa.initialState < 0)
+		return;
+	nfa.addEpsilon(start, nfa.addDFA(dfa, code, AUTOMATON_PRIORITY));
+}
+
+void LexerDFA::addRegex(const string& pattern, int code, int priority)
+{
+	nfa.addEpsilon(start, nfa.addRegex(pattern, code, priority));
+}
+
+void LexerDFA::build()
+{
+	DFATable dfa = nfa.determinize(start);
+	determinizedStateCount = dfa.stateCount;
+	table = minimizeDFA(dfa);
+}
+
+void LexerDFA::load(const DFATable& builtTable)
+{
+	table = builtTable;
+	determinizedStateCount = table.stateCount;
+}
+
+void LexerDFA::displayMinimizationReport() const
+{
+	cout << "Lexer states: " << nfa.stateCount() << " in the NFA, " << determinizedStateCount
+		<< " after subset construction, " << table.stateCount << " after minimization" << endl;
+}
+
+size_t LexerDFA::match(const char* begin, const char* end, int& code, bool& reachedEnd) const
+{
+	size_t length = 0;
+	int state = table.initialState;
+	reachedEnd = false;
+
+	const char* curr = begin;
+	for (;;) {
+		if (curr == end) {
+			reachedEnd = true;
+			break;
+		}
+		state = table.step(state, static_cast<unsigned char>(*curr++));
+		if (state < 0)
+			break;
+
+		//remember the last accepting state we went through
+		if (table.accept[state] >= 0) {
+			length = curr - begin;
+			code = table.accept[state];
+		}
+	}
+
+	STATS_ADD(LexerTransitions, curr - begin);
+	return length;
+}
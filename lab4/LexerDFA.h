@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include "NFA.h"
+
+// union of every token class of the language in a single DFA
+// matching runs once over the input with maximal munch, when several token classes accept
+// the same lexeme the one added with the lower priority value wins (reserved words before identifiers)
+class LexerDFA {
+public:
+    LexerDFA();
+
+    void addKeyword(const std::string& text, int code);
+    void addAutomaton(const FA& fa, int code);
+    // keywords have priority 0, a token class has to have a higher value to lose to them
+    void addRegex(const std::string& pattern, int code, int priority);
+    void build();
+    // uses an already built table instead of the added keywords and automata
+    void load(const DFATable& builtTable);
+
+    // length of the longest token at the start of [begin, end), 0 if there is none
+    // code receives the token code of the match, reachedEnd is set when the automaton was still
+    // running at end, so a longer token is possible once more input is available
+    size_t match(const char* begin, const char* end, int& code, bool& reachedEnd) const;
+
+    const DFATable& getTable() const { return table; }
+    void displayMinimizationReport() const;
+
+private:
+    static const int KEYWORD_PRIORITY = 0;
+    static const int AUTOMATON_PRIORITY = 1;
+
+    NFA nfa;
+    int start;
+    int determinizedStateCount;
+    DFATable table;
+};
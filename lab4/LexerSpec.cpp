@@ -0,0 +1,214 @@
+#include "LexerSpec.h"
+#include "Statistics.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+//true when a token can go on after reading a new line, from any state the automaton reaches, the initial one too
+static bool readsPastNewLine(const DFATable& table)
+{
+	if (table.initialState < 0) {
+		return false;
+	}
+	vector<bool> seen(table.stateCount, false);
+	vector<int> work{ table.initialState };
+	seen[table.initialState] = true;
+	while (!work.empty()) {
+		int state = work.back();
+		work.pop_back();
+		int afterNewLine = table.step(state, '\n');
+		if (afterNewLine >= 0) {
+			for (int ch = 0; ch < 256; ch++) {
+				if (table.step(afterNewLine, static_cast<unsigned char>(ch)) >= 0) {
+					return true;
+				}
+			}
+		}
+		for (int ch = 0; ch < 256; ch++) {
+			int target = table.step(state, static_cast<unsigned char>(ch));
+			if (target >= 0 && !seen[target]) {
+				seen[target] = true;
+				work.push_back(target);
+			}
+		}
+	}
+	return false;
+}
+
+//true when a token that starts with one of the first bytes can read one of the stop bytes after its first byte
+static bool continuesOver(const DFATable& table, const array<bool, 256>& first, const array<bool, 256>& stop)
+{
+	if (table.initialState < 0) {
+		return false;
+	}
+	vector<bool> seen(table.stateCount, false);
+	vector<int> work;
+	for (int ch = 0; ch < 256; ch++) {
+		int state = table.step(table.initialState, static_cast<unsigned char>(ch));
+		if (first[ch] && state >= 0 && !seen[state]) {
+			seen[state] = true;
+			work.push_back(state);
+		}
+	}
+	while (!work.empty()) {
+		int state = work.back();
+		work.pop_back();
+		for (int ch = 0; ch < 256; ch++) {
+			int target = table.step(state, static_cast<unsigned char>(ch));
+			if (target < 0) {
+				continue;
+			}
+			if (stop[ch]) {
+				return true;
+			}
+			if (!seen[target]) {
+				seen[target] = true;
+				work.push_back(target);
+			}
+		}
+	}
+	return false;
+}
+
+
+LexerSpec::LexerSpec()
+{
+	STATS_PHASE(LoadSpec);
+	initTokens();
+
+	finiteAutomataIdentifier= FA("FA-identifier.in");
+	finiteAutomataInteger= FA("FA-integer.in");
+	finiteAutomataString = FA("FA-string.in");
+	addKeywords();
+	lexer.addAutomaton(finiteAutomataIdentifier, IDENTIFIER_CODE);
+	lexer.addAutomaton(finiteAutomataInteger, CONSTANT_CODE);
+	lexer.addAutomaton(finiteAutomataString, CONSTANT_CODE);
+	lexer.build();
+	initClassifiers();
+}
+
+LexerSpec::LexerSpec(const string& lexerSpecPath)
+{
+	STATS_PHASE(LoadSpec);
+	initTokens();
+	addKeywords();
+	readTokenClasses(lexerSpecPath);
+	lexer.build();
+	initClassifiers();
+}
+
+void LexerSpec::initTokens() {
+	ifstream tokensFile("token.txt");
+	string token;
+	int index = 1;
+	while (getline(tokensFile, token)) {
+		if (token == "\\n") {
+			token = "\n";
+		}
+		if (index <= 11) {
+			this->tokens.add(token, TokenCategory::Operator, index);
+		}
+		else if (index <= 22) {
+			this->tokens.add(token, TokenCategory::Separator, index);
+		}
+		else {
+			this->tokens.add(token, TokenCategory::ReservedWord, index);
+		}
+		index++;
+	}
+	this->tokens.build();
+}
+
+void LexerSpec::displayTokens() const {
+	for (int i = 0; i < tokens.size(); i++) {
+		TokenTable::Entry entry = tokens.getEntry(i);
+		cout << "Token: " << tokens.getText(i) << " -> type: " << categoryName(entry.category) << ", code: " << entry.code << endl;
+	}
+}
+
+void LexerSpec::addKeywords()
+{
+	//in code order, so the built tables are the same whatever order token.txt lists them in
+	vector<pair<int, string>> byCode;
+	for (int i = 0; i < tokens.size(); i++) {
+		byCode.push_back({ tokens.getEntry(i).code, string(tokens.getText(i)) });
+	}
+	sort(byCode.begin(), byCode.end());
+
+	//reserved words and operators are added before the automata so they win over identifiers
+	for (const auto& token : byCode) {
+		lexer.addKeyword(token.second, token.first);
+		if (isSeparator(token.second)) {
+			delimiters[static_cast<unsigned char>(token.second[0])] = true;
+		}
+	}
+	delimiters['\t'] = true;
+	delimiters['\r'] = true;
+}
+
+void LexerSpec::readTokenClasses(const string& path)
+{
+	ifstream file(path);
+	if (!file.is_open()) {
+		throw runtime_error("Could not open the lexer spec " + path);
+	}
+
+	//blank lines and lines starting with # are skipped, the expression is the rest of the line
+	string line;
+	int lineNumber = 0;
+	while (getline(file, line)) {
+		lineNumber++;
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		size_t first = line.find_first_not_of(" \t");
+		if (first == string::npos || line[first] == '#') {
+			continue;
+		}
+
+		istringstream fields(line);
+		int priority;
+		int code;
+		string expression;
+		if (!(fields >> priority >> code) || !(fields >> ws) || !getline(fields, expression) || expression.empty()) {
+			throw invalid_argument(path + " line " + to_string(lineNumber) + ": expected priority, code and expression");
+		}
+		try {
+			lexer.addRegex(expression, code, priority);
+		}
+		catch (const invalid_argument& e) {
+			throw invalid_argument(path + " line " + to_string(lineNumber) + ": " + e.what());
+		}
+
+		//checked on the class alone too, so the error can say which line it is
+		NFA single;
+		DFATable table = single.determinize(single.addRegex(expression, code, priority));
+		if (readsPastNewLine(table)) {
+			throw invalid_argument(path + " line " + to_string(lineNumber) + ": a new line can only be the last byte of a token");
+		}
+	}
+}
+
+void LexerSpec::initClassifiers()
+{
+	delimiterClassifier = ByteClassifier(delimiters);
+	array<bool, 256> ignored{};
+	ignored['\t'] = true;
+	ignored['\r'] = true;
+	ignoredClassifier = ByteClassifier(ignored);
+
+	//scanning in chunks, relexing after an edit and reading block by block all restart right after a new line
+	if (readsPastNewLine(lexer.getTable())) {
+		throw runtime_error("A token class of the lexer spec can go on after a new line");
+	}
+
+	//follow every token that starts with a non delimiter, none of them may go on over a delimiter
+	array<bool, 256> words;
+	for (int ch = 0; ch < 256; ch++) {
+		words[ch] = !delimiters[ch];
+	}
+	endAtDelimiters = !continuesOver(lexer.getTable(), words, delimiters);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <array>
+#include <memory>
+#include "FiniteAutomata.h"
+#include "LexerDFA.h"
+#include "TokenTable.h"
+#include "ByteClassifier.h"
+
+// everything the scanner needs to know about the language, loaded once from token.txt and the FA files
+// it is never changed after construction, so one instance can be shared by any number of scanners and threads
+class LexerSpec {
+public:
+    // reads the language from the working directory
+    LexerSpec();
+    // operators, separators and reserved words from token.txt, the other token classes from a file of regular expressions
+    // instead of the FA files, one class per line as "priority code expression", see token.lex
+    // throws invalid_argument for a class that can read anything after a new line
+    explicit LexerSpec(const std::string& lexerSpecPath);
+    // takes the language from the tables lexgen wrote to LexerTables.h, nothing is read at startup
+    static std::shared_ptr<const LexerSpec> fromGeneratedTables();
+    bool usesGeneratedTables() const { return generated; }
+
+    static const int IDENTIFIER_CODE = 37;
+    static const int CONSTANT_CODE = 38;
+
+    const LexerDFA& getLexer() const { return lexer; }
+    // first characters of the separators, every other token has to be followed by one of them
+    bool isDelimiter(unsigned char character) const { return delimiters[character]; }
+    size_t match(const char* begin, const char* end, int& code, bool& reachedEnd) const {
+        return lexer.match(begin, end, code, reachedEnd);
+    }
+    // finds the delimiter a token has to stop at, and the end of a run of skipped characters (tabs, carriage returns)
+    const ByteClassifier& getDelimiterClassifier() const { return delimiterClassifier; }
+    const ByteClassifier& getIgnoredClassifier() const { return ignoredClassifier; }
+    // true when no token that starts with a non delimiter has a delimiter inside it,
+    // then such a token is exactly the run of bytes up to the next delimiter
+    bool tokensEndAtDelimiters() const { return endAtDelimiters; }
+
+    bool isSeparator(std::string_view token) const { return tokens.category(token) == TokenCategory::Separator; }
+    bool isOperator(std::string_view token) const { return tokens.category(token) == TokenCategory::Operator; }
+    bool isReservedWord(std::string_view token) const { return tokens.category(token) == TokenCategory::ReservedWord; }
+    void displayTokens() const;
+    // category and code of every operator, separator and reserved word
+    const TokenTable& getTokens() const { return tokens; }
+
+private:
+    TokenTable tokens;
+    FA finiteAutomataInteger;
+    FA finiteAutomataIdentifier;
+    FA finiteAutomataString;
+    LexerDFA lexer;
+    std::array<bool, 256> delimiters{};
+    ByteClassifier delimiterClassifier;
+    ByteClassifier ignoredClassifier;
+    bool endAtDelimiters = false;
+    bool generated = false;
+
+    struct Generated {};
+    explicit LexerSpec(Generated);
+    void initTokens();
+    void addKeywords();
+    void readTokenClasses(const std::string& path);
+    void initClassifiers();
+};
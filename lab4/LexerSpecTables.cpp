@@ -0,0 +1,37 @@
+#include "LexerSpec.h"
+#include "LexerTables.h"
+#include "Statistics.h"
+#include <iterator>
+using namespace std;
+
+// kept apart from LexerSpec.cpp because lexgen links that file to write LexerTables.h in the first place
+
+LexerSpec::LexerSpec(Generated) : generated(true)
+{
+	STATS_PHASE(LoadSpec);
+	for (int i = 0; i < LexerTables::tokenCount; i++) {
+		tokens.add(LexerTables::tokenTexts[i], LexerTables::tokenCategories[i], i + 1);
+	}
+	tokens.build();
+	for (int ch = 0; ch < 256; ch++) {
+		delimiters[ch] = LexerTables::delimiters[ch];
+	}
+
+	//a runtime copy of the tables, for the code that looks at the DFA itself
+	DFATable table;
+	table.classCount = LexerTables::classCount;
+	table.stateCount = LexerTables::stateCount;
+	table.initialState = LexerTables::initialState;
+	for (int ch = 0; ch < 256; ch++) {
+		table.charClass[ch] = LexerTables::charClass[ch];
+	}
+	table.next.assign(begin(LexerTables::next), end(LexerTables::next));
+	table.accept.assign(begin(LexerTables::accept), end(LexerTables::accept));
+	lexer.load(table);
+	initClassifiers();
+}
+
+shared_ptr<const LexerSpec> LexerSpec::fromGeneratedTables()
+{
+	return shared_ptr<const LexerSpec>(new LexerSpec(Generated()));
+}
@@ -0,0 +1,320 @@
+// generated by lexgen from token.txt and the FA-*.in files, do not edit
+#pragma once
+#include "TokenTable.h"
+
+enum class TokenCode : int {
+    Plus = 1,
+    Minus = 2,
+    Times = 3,
+    Div = 4,
+    Gt = 5,
+    Gte = 6,
+    Eq = 7,
+    Mod = 8,
+    Lt = 9,
+    Lte = 10,
+    Ne = 11,
+    LeftBracket = 12,
+    RightBracket = 13,
+    Colon = 14,
+    Space = 15,
+    Comma = 16,
+    Tilde = 17,
+    NewLine = 18,
+    GreaterGreater = 19,
+    LessLess = 20,
+    LeftParen = 21,
+    RightParen = 22,
+    Num = 23,
+    Boolean = 24,
+    Str = 25,
+    Entry = 26,
+    For = 27,
+    Until = 28,
+    If = 29,
+    Else = 30,
+    Stop = 31,
+    True = 32,
+    False = 33,
+    Is = 34,
+    Input = 35,
+    Output = 36,
+    Identifier = 37,
+    Constant = 38
+};
+
+struct LexerTables {
+    static constexpr int classCount = 35;
+    static constexpr int stateCount = 96;
+    static constexpr int initialState = 0;
+    static constexpr int tokenCount = 36;
+
+    static constexpr unsigned char charClass[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        2, 0, 3, 0, 0, 0, 0, 0, 4, 5, 0, 6, 7, 6, 0, 0,
+        8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 9, 0, 10, 0, 11, 0,
+        0, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 13, 0, 14, 0, 0,
+        0, 15, 16, 12, 17, 18, 19, 20, 12, 21, 12, 12, 22, 23, 24, 25,
+        26, 27, 28, 29, 30, 31, 32, 12, 12, 33, 12, 0, 0, 0, 34, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+    static constexpr short next[stateCount * classCount] = {
+        -1, 1, 2, 3, 4, 5, 6, 7, 6, 8, 9, 10, 11, 12, 13, 11,
+        14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 11, 11, 25, 26, 27,
+        11, 11, 28, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 29, -1, -1, -1,
+        -1, 3, -1, -1, -1, 3, -1, -1, 3, 3, 3, 3, 3, 3, 3, 3,
+        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 6, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 30, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 32, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11,
+        11, 11, 33, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11,
+        11, 11, 11, 11, 11, 11, 34, 11, 35, 11, 11, 36, 11, 11, 11, 11,
+        11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11,
+        -1, -1, 37, 11, 11, 11, 11, 11, 11, 11, 11, 11, 38, 11, 11, 11,
+        11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1,
+        -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 39, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 40, 11, 11, 11,
+        11, 41, 11, 11, 11, 11, 42, 11, 11, 11, 11, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 43, 11, 11, 11, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11,
+        11, 11, 11, 11, 44, 11, 11, 11, 45, 11, 11, 11, 11, 11, 11, 11,
+        11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1,
+        -1, 11, 11, 11, 46, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 47, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1,
+        -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 48, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 49, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 50, 11, 11, 11, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11,
+        11, 11, 11, 51, 11, 11, 11, 11, 11, 11, 52, 11, 11, 11, 11, 11,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 53, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 54, 11, 11, 11, 11, 11, 11,
+        11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11,
+        -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 55, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1,
+        -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 56, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 57, 11, 11, 11, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11,
+        11, 11, 11, 11, 11, 58, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1,
+        -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 59, 11,
+        11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1,
+        -1, 11, -1, -1, 11, 11, 11, 60, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 61, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 62, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1,
+        11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 63, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11,
+        -1, -1, -1, 11, -1, -1, 11, 11, 64, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11,
+        11, 11, 11, 11, 65, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 66, 11,
+        11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11,
+        -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 67, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1,
+        -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 68,
+        11, 11, 69, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11,
+        70, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 71, 11, 11, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 72, 11, 11,
+        11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1,
+        -1, 11, 11, 11, 11, 11, 11, 11, 73, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1,
+        -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 74, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 75, 11, 11, 11, 11, 11, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 76, 11, 11, 11, 11,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1,
+        11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11,
+        -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 77, 11, 11, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 78, 11, 11, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11,
+        -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1,
+        -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        79, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 80, 11, 11, 11, 11, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 81, 11, 11, 11, 11, 11, 11, 11, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1,
+        -1, 11, 11, 11, 82, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1,
+        -1, 11, -1, -1, 11, 11, 11, 83, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 84, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 85, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 86, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1,
+        11, -1, -1, 11, 11, 11, 87, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11,
+        -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 88, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 89, 11, 11, 11, 11, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 90, 11, 11, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11,
+        -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1,
+        -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 91, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11,
+        11, 11, 92, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 93, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1,
+        -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1,
+        -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 94, 11, 11, 11,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, -1, -1, -1,
+        11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11,
+        -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11, 11, 11, 95,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, 11, -1, -1, -1, 11, -1, -1, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, -1
+    };
+    static constexpr signed char accept[stateCount] = {
+        -1, 18, 15, -1, 21, 22, 38, 16, 14, -1, -1, 37, 12, 13, 37, 37,
+        37, 37, 37, 37, 37, 37, 37, 37, 37, 37, 37, 37, 17, 38, 20, 19,
+        37, 37, 37, 37, 7, 37, 37, 5, 29, 37, 34, 9, 37, 37, 11, 37,
+        37, 37, 37, 37, 37, 37, 37, 4, 37, 37, 37, 27, 6, 37, 10, 37,
+        8, 23, 37, 37, 37, 25, 37, 37, 37, 37, 30, 37, 37, 37, 37, 37,
+        1, 31, 37, 32, 37, 37, 26, 33, 35, 2, 37, 3, 28, 37, 36, 24
+    };
+    static constexpr bool delimiters[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    // text and category of the token with code i + 1
+    static constexpr const char* tokenTexts[tokenCount] = {
+        "plus", "minus", "times", "div", "gt", "gte", "eq", "mod", "lt", "lte", "ne", "[", "]", ":", " ", ",",
+        "~", "\n", ">>", "<<", "(", ")", "num", "boolean", "str", "entry", "for", "until", "if", "else", "stop", "true",
+        "false", "is", "input", "output"
+    };
+    static constexpr TokenCategory tokenCategories[tokenCount] = {
+        TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Operator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator,
+        TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::Separator, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord,
+        TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord, TokenCategory::ReservedWord
+    };
+};
@@ -0,0 +1,57 @@
+#include "LineTable.h"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+void LineTable::addNewLines(const char* text, size_t length, size_t offset)
+{
+	//memchr is vectorized by the library, it skips the long runs between new lines quickly
+	const char* end = text + length;
+	for (const char* curr = text; curr < end; curr++) {
+		curr = static_cast<const char*>(memchr(curr, '\n', end - curr));
+		if (curr == nullptr) {
+			break;
+		}
+		addNewLine(offset + (curr - text));
+	}
+}
+
+size_t LineTable::after(size_t offset) const
+{
+	size_t first = 0;
+	size_t remaining = starts.size();
+	while (remaining > 0) {
+		size_t half = remaining / 2;
+		if (start(first + half) <= offset) {
+			first += half + 1;
+			remaining -= half + 1;
+		}
+		else {
+			remaining = half;
+		}
+	}
+	return first;
+}
+
+void LineTable::edit(size_t offset, size_t removed, string_view inserted)
+{
+	//lines that started right after a removed new line are gone, the ones after the removed text move
+	size_t first = after(offset);
+	size_t last = after(offset + removed);
+
+	starts.replace(first, last, static_cast<size_t>(count(inserted.begin(), inserted.end(), '\n')));
+	size_t line = first;
+	for (size_t i = 0; i < inserted.size(); i++) {
+		if (inserted[i] == '\n') {
+			starts.set(line++, offset + i + 1);
+		}
+	}
+	starts.shiftAfterGap(static_cast<long long>(inserted.size()) - static_cast<long long>(removed));
+}
+
+SourcePosition LineTable::find(size_t offset) const
+{
+	//the line is the last one that starts at or before offset, the first line starts at 0 so there always is one
+	size_t line = after(offset);
+	return { static_cast<int>(line), static_cast<int>(offset - start(line - 1)) + 1 };
+}
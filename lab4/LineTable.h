@@ -0,0 +1,42 @@
+#pragma once
+#include <string_view>
+#include <cstdint>
+#include "GapColumn.h"
+
+// line and column of a byte of the program, both counted from 1, the column in bytes
+struct SourcePosition {
+    int line;
+    int column;
+};
+
+// the offset every line of the program starts at, so the position of any token is found from its offset
+// with a binary search instead of every token carrying its line and column
+//
+// an edit leaves the gap of the column after the lines it put in, like the PIF does after a splice,
+// so an edit only moves the lines between it and the edit before
+class LineTable {
+public:
+    LineTable() { starts.push_back(0); }
+
+    void clear() {
+        starts.clear();
+        starts.push_back(0);
+    }
+    // the next line starts after the new line at offset, new lines have to be added in the order of the text
+    void addNewLine(size_t offset) { starts.push_back(offset + 1); }
+    // all of the new lines in text, which is at offset in the program
+    void addNewLines(const char* text, size_t length, size_t offset);
+    // the same change SourceBuffer::edit makes to the text
+    void edit(size_t offset, size_t removed, std::string_view inserted);
+
+    SourcePosition find(size_t offset) const;
+    int lineCount() const { return static_cast<int>(starts.size()); }
+    size_t lineStart(int line) const { return start(line - 1); }
+
+private:
+    GapColumn<uint64_t> starts;
+
+    size_t start(size_t index) const { return static_cast<size_t>(starts.get(index)); }
+    // index of the first line that starts after offset
+    size_t after(size_t offset) const;
+};
@@ -0,0 +1,637 @@
+#include "NFA.h"
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+using namespace std;
+
+int NFA::addState(int acceptTag, int priority)
+{
+	edges.emplace_back();
+	epsilon.emplace_back();
+	accept.push_back(acceptTag);
+	priorities.push_back(priority);
+	return static_cast<int>(edges.size()) - 1;
+}
+
+void NFA::addEdge(int from, const bitset<256>& bytes, int to)
+{
+	edges[from].push_back({ bytes, to });
+}
+
+void NFA::addEpsilon(int from, int to)
+{
+	epsilon[from].push_back(to);
+}
+
+int NFA::addDFA(const DFATable& dfa, int acceptTag, int priority)
+{
+	//bytes belonging to each character class of the dfa
+	vector<bitset<256>> classBytes(dfa.classCount);
+	for (int ch = 0; ch < 256; ch++)
+		classBytes[dfa.charClass[ch]].set(ch);
+
+	int offset = stateCount();
+	for (int state = 0; state < dfa.stateCount; state++)
+		addState(dfa.isAccepting(state) ? acceptTag : -1, priority);
+
+	for (int state = 0; state < dfa.stateCount; state++) {
+		//class 0 is never part of the alphabet
+		for (int cls = 1; cls < dfa.classCount; cls++) {
+			int target = dfa.next[state * dfa.classCount + cls];
+			if (target >= 0)
+				addEdge(offset + state, classBytes[cls], offset + target);
+		}
+	}
+
+	return offset + dfa.initialState;
+}
+
+int NFA::addLiteral(const string& text, int acceptTag, int priority)
+{
+	int start = addState(text.empty() ? acceptTag : -1, priority);
+	int curr = start;
+	for (size_t i = 0; i < text.size(); i++) {
+		int next = addState(i + 1 == text.size() ? acceptTag : -1, priority);
+		bitset<256> bytes;
+		bytes.set(static_cast<unsigned char>(text[i]));
+		addEdge(curr, bytes, next);
+		curr = next;
+	}
+	return start;
+}
+
+// recursive descent over the pattern, every part becomes a fragment of states with one way in and one way out,
+// the way out has no edges yet so the next part can be joined to it with an epsilon
+class RegexParser {
+public:
+	RegexParser(NFA& nfa, string_view pattern, int priority) : nfa(nfa), pattern(pattern), pos(0), priority(priority) {}
+
+	int compile(int acceptTag)
+	{
+		Fragment whole = alternation();
+		if (pos < pattern.size()) {
+			fail("unmatched )");
+		}
+		int accepting = nfa.addState(acceptTag, priority);
+		nfa.addEpsilon(whole.end, accepting);
+		return whole.start;
+	}
+
+private:
+	struct Fragment {
+		int start;
+		int end;
+	};
+
+	NFA& nfa;
+	string_view pattern;
+	size_t pos;
+	int priority;
+
+	[[noreturn]] void fail(const string& message) const
+	{
+		throw invalid_argument("Regular expression " + string(pattern) + ": " + message + " at position " + to_string(pos));
+	}
+
+	bool more() const { return pos < pattern.size(); }
+	char peek() const { return pattern[pos]; }
+
+	Fragment empty()
+	{
+		Fragment fragment{ nfa.addState(-1, priority), nfa.addState(-1, priority) };
+		nfa.addEpsilon(fragment.start, fragment.end);
+		return fragment;
+	}
+
+	Fragment bytes(const bitset<256>& set)
+	{
+		Fragment fragment{ nfa.addState(-1, priority), nfa.addState(-1, priority) };
+		nfa.addEdge(fragment.start, set, fragment.end);
+		return fragment;
+	}
+
+	Fragment alternation()
+	{
+		Fragment first = concatenation();
+		if (!more() || peek() != '|') {
+			return first;
+		}
+		Fragment fragment{ nfa.addState(-1, priority), nfa.addState(-1, priority) };
+		nfa.addEpsilon(fragment.start, first.start);
+		nfa.addEpsilon(first.end, fragment.end);
+		while (more() && peek() == '|') {
+			pos++;
+			Fragment next = concatenation();
+			nfa.addEpsilon(fragment.start, next.start);
+			nfa.addEpsilon(next.end, fragment.end);
+		}
+		return fragment;
+	}
+
+	Fragment concatenation()
+	{
+		if (!more() || peek() == '|' || peek() == ')') {
+			return empty();
+		}
+		Fragment fragment = repetition();
+		while (more() && peek() != '|' && peek() != ')') {
+			Fragment next = repetition();
+			nfa.addEpsilon(fragment.end, next.start);
+			fragment.end = next.end;
+		}
+		return fragment;
+	}
+
+	Fragment repetition()
+	{
+		Fragment fragment = atom();
+		while (more() && (peek() == '*' || peek() == '+' || peek() == '?')) {
+			char op = pattern[pos++];
+			Fragment repeated{ nfa.addState(-1, priority), nfa.addState(-1, priority) };
+			nfa.addEpsilon(repeated.start, fragment.start);
+			nfa.addEpsilon(fragment.end, repeated.end);
+			if (op != '+') {
+				nfa.addEpsilon(repeated.start, repeated.end);
+			}
+			if (op != '?') {
+				nfa.addEpsilon(fragment.end, fragment.start);
+			}
+			fragment = repeated;
+		}
+		return fragment;
+	}
+
+	Fragment atom()
+	{
+		char ch = pattern[pos++];
+		bitset<256> set;
+		switch (ch) {
+		case '(': {
+			Fragment group = alternation();
+			if (!more() || peek() != ')') {
+				fail("missing )");
+			}
+			pos++;
+			return group;
+		}
+		case '[':
+			return bytes(byteClass());
+		case '.':
+			set.set();
+			set.reset('\n');
+			return bytes(set);
+		case '*':
+		case '+':
+		case '?':
+			pos--;
+			fail(string("nothing to repeat before ") + ch);
+		case '\\':
+			return bytes(escape());
+		default:
+			set.set(static_cast<unsigned char>(ch));
+			return bytes(set);
+		}
+	}
+
+	// the bytes of the escape after a backslash
+	bitset<256> escape()
+	{
+		if (!more()) {
+			fail("\\ at the end");
+		}
+		char ch = pattern[pos++];
+		bitset<256> set;
+		switch (ch) {
+		case 'd':
+			addRange(set, '0', '9');
+			break;
+		case 'w':
+			addRange(set, 'a', 'z');
+			addRange(set, 'A', 'Z');
+			addRange(set, '0', '9');
+			set.set('_');
+			break;
+		case 's':
+			set.set(' ');
+			set.set('\t');
+			set.set('\r');
+			set.set('\n');
+			break;
+		case 'n':
+			set.set('\n');
+			break;
+		case 't':
+			set.set('\t');
+			break;
+		case 'r':
+			set.set('\r');
+			break;
+		default:
+			set.set(static_cast<unsigned char>(ch));
+			break;
+		}
+		return set;
+	}
+
+	static void addRange(bitset<256>& set, unsigned char first, unsigned char last)
+	{
+		for (int ch = first; ch <= last; ch++) {
+			set.set(ch);
+		}
+	}
+
+	// the one byte in the set, -1 if there are more
+	static int onlyByte(const bitset<256>& set)
+	{
+		if (set.count() != 1) {
+			return -1;
+		}
+		int ch = 0;
+		while (!set.test(ch)) {
+			ch++;
+		}
+		return ch;
+	}
+
+	// a byte of a class, or the bytes of an escape in it
+	bitset<256> classMember()
+	{
+		char ch = pattern[pos++];
+		if (ch == '\\') {
+			return escape();
+		}
+		bitset<256> set;
+		set.set(static_cast<unsigned char>(ch));
+		return set;
+	}
+
+	// a ] right after [ or [^ is one of the bytes, a - at either end too
+	bitset<256> byteClass()
+	{
+		bitset<256> set;
+		bool negated = more() && peek() == '^';
+		if (negated) {
+			pos++;
+		}
+		bool first = true;
+		while (more() && (peek() != ']' || first)) {
+			first = false;
+			bitset<256> member = classMember();
+			int low = onlyByte(member);
+			if (low < 0 || pos + 1 >= pattern.size() || peek() != '-' || pattern[pos + 1] == ']') {
+				set |= member;
+				continue;
+			}
+			pos++;
+			int high = onlyByte(classMember());
+			if (high < 0) {
+				fail("class escape at the end of a range");
+			}
+			if (high < low) {
+				fail("range out of order");
+			}
+			addRange(set, static_cast<unsigned char>(low), static_cast<unsigned char>(high));
+		}
+		if (!more()) {
+			fail("missing ]");
+		}
+		pos++;
+		if (negated) {
+			set.flip();
+		}
+		return set;
+	}
+};
+
+int NFA::addRegex(string_view pattern, int acceptTag, int priority)
+{
+	return RegexParser(*this, pattern, priority).compile(acceptTag);
+}
+
+void NFA::closure(vector<int>& stateSet) const
+{
+	vector<bool> seen(edges.size(), false);
+	for (int state : stateSet)
+		seen[state] = true;
+
+	for (size_t i = 0; i < stateSet.size(); i++) {
+		for (int target : epsilon[stateSet[i]]) {
+			if (!seen[target]) {
+				seen[target] = true;
+				stateSet.push_back(target);
+			}
+		}
+	}
+	sort(stateSet.begin(), stateSet.end());
+}
+
+DFATable NFA::determinize(int start) const
+{
+	DFATable dfa;
+
+	//bytes that take exactly the same edges end up in the same character class
+	//the class of bytes that take no edge at all is class 0
+	vector<const Edge*> allEdges;
+	for (const auto& stateEdges : edges)
+		for (const Edge& edge : stateEdges)
+			allEdges.push_back(&edge);
+
+	map<vector<bool>, int> signatures;
+	signatures[vector<bool>(allEdges.size(), false)] = 0;
+	vector<int> representative(1, -1);
+	for (int ch = 0; ch < 256; ch++) {
+		vector<bool> signature(allEdges.size());
+		for (size_t i = 0; i < allEdges.size(); i++)
+			signature[i] = allEdges[i]->bytes.test(ch);
+
+		auto res = signatures.insert({ signature, static_cast<int>(signatures.size()) });
+		if (res.second)
+			representative.push_back(ch);
+		dfa.charClass[ch] = res.first->second;
+	}
+	dfa.classCount = static_cast<int>(signatures.size());
+
+	//subset construction
+	map<vector<int>, int> subsetIds;
+	vector<vector<int>> subsets;
+
+	auto idOf = [&](vector<int>& subset) {
+		closure(subset);
+		auto res = subsetIds.insert({ subset, static_cast<int>(subsets.size()) });
+		if (res.second)
+			subsets.push_back(subset);
+		return res.first->second;
+	};
+
+	vector<int> initial(1, start);
+	dfa.initialState = idOf(initial);
+
+	for (size_t curr = 0; curr < subsets.size(); curr++) {
+		int tag = -1;
+		int bestPriority = 0;
+		for (int state : subsets[curr]) {
+			if (accept[state] >= 0 && (tag < 0 || priorities[state] < bestPriority)) {
+				tag = accept[state];
+				bestPriority = priorities[state];
+			}
+		}
+		dfa.accept.push_back(tag);
+
+		dfa.next.resize(subsets.size() * dfa.classCount, -1);
+		for (int cls = 1; cls < dfa.classCount; cls++) {
+			int ch = representative[cls];
+			vector<int> moved;
+			for (int state : subsets[curr])
+				for (const Edge& edge : edges[state])
+					if (edge.bytes.test(ch))
+						moved.push_back(edge.target);
+
+			if (moved.empty())
+				continue;
+			sort(moved.begin(), moved.end());
+			moved.erase(unique(moved.begin(), moved.end()), moved.end());
+
+			int target = idOf(moved);
+			dfa.next.resize(subsets.size() * dfa.classCount, -1);
+			dfa.next[curr * dfa.classCount + cls] = target;
+		}
+	}
+
+	dfa.stateCount = static_cast<int>(subsets.size());
+	dfa.next.resize(dfa.stateCount * dfa.classCount, -1);
+	return dfa;
+}
+
+namespace {
+
+// partition of the states into blocks that can be split by marking some of their states
+class Partition {
+public:
+	explicit Partition(int stateCount) : elements(stateCount), location(stateCount), blockOf(stateCount) {
+		for (int state = 0; state < stateCount; state++) {
+			elements[state] = state;
+			location[state] = state;
+		}
+	}
+
+	int blockCount() const { return static_cast<int>(first.size()); }
+	int block(int state) const { return blockOf[state]; }
+	int size(int block) const { return last[block] - first[block]; }
+	int element(int block, int index) const { return elements[first[block] + index]; }
+
+	//states must be added block after block
+	void addBlock(const vector<int>& statesOfBlock) {
+		int block = blockCount();
+		first.push_back(positionFill);
+		for (int state : statesOfBlock) {
+			elements[positionFill] = state;
+			location[state] = positionFill++;
+			blockOf[state] = block;
+		}
+		last.push_back(positionFill);
+		markedCount.push_back(0);
+	}
+
+	//moves the state to the marked front part of its block
+	void mark(int state) {
+		int block = blockOf[state];
+		int target = first[block] + markedCount[block];
+		if (location[state] < target)
+			return;
+		int other = elements[target];
+		swap(elements[location[state]], elements[target]);
+		location[other] = location[state];
+		location[state] = target;
+		if (markedCount[block]++ == 0)
+			touched.push_back(block);
+	}
+
+	//splits every touched block into its marked and unmarked part, returns the pairs (old block, new block)
+	vector<pair<int, int>> split() {
+		vector<pair<int, int>> splits;
+		for (int block : touched) {
+			int marked = markedCount[block];
+			markedCount[block] = 0;
+			if (marked == size(block))
+				continue;
+
+			int newBlock = blockCount();
+			first.push_back(first[block]);
+			last.push_back(first[block] + marked);
+			markedCount.push_back(0);
+			first[block] += marked;
+			for (int pos = first[newBlock]; pos < last[newBlock]; pos++)
+				blockOf[elements[pos]] = newBlock;
+			splits.push_back({ block, newBlock });
+		}
+		touched.clear();
+		return splits;
+	}
+
+private:
+	vector<int> elements;
+	vector<int> location;
+	vector<int> blockOf;
+	vector<int> first;
+	vector<int> last;
+	vector<int> markedCount;
+	vector<int> touched;
+	int positionFill = 0;
+};
+
+}
+
+DFATable minimizeDFA(const DFATable& dfa)
+{
+	int n = dfa.stateCount;
+	int classCount = dfa.classCount;
+	if (dfa.initialState < 0)
+		return dfa;
+
+	//keep the states that are reachable from the start and can still reach a final state
+	vector<bool> reachable(n, false);
+	vector<int> queue(1, dfa.initialState);
+	reachable[dfa.initialState] = true;
+	for (size_t i = 0; i < queue.size(); i++) {
+		for (int cls = 1; cls < classCount; cls++) {
+			int target = dfa.next[queue[i] * classCount + cls];
+			if (target >= 0 && !reachable[target]) {
+				reachable[target] = true;
+				queue.push_back(target);
+			}
+		}
+	}
+
+	vector<vector<int>> reverse(n);
+	for (int state = 0; state < n; state++)
+		for (int cls = 1; cls < classCount; cls++) {
+			int target = dfa.next[state * classCount + cls];
+			if (target >= 0)
+				reverse[target].push_back(state);
+		}
+
+	vector<bool> live(n, false);
+	queue.clear();
+	for (int state = 0; state < n; state++) {
+		if (dfa.isAccepting(state)) {
+			live[state] = true;
+			queue.push_back(state);
+		}
+	}
+	for (size_t i = 0; i < queue.size(); i++) {
+		for (int source : reverse[queue[i]]) {
+			if (!live[source]) {
+				live[source] = true;
+				queue.push_back(source);
+			}
+		}
+	}
+
+	//hopcroft works on a complete automaton, every missing transition goes to an explicit sink
+	int sink = n;
+	auto target = [&](int state, int cls) {
+		if (state == sink)
+			return sink;
+		int next = dfa.next[state * classCount + cls];
+		return next >= 0 && reachable[next] && live[next] ? next : sink;
+	};
+
+	vector<int> kept;
+	for (int state = 0; state < n; state++)
+		if (reachable[state] && live[state])
+			kept.push_back(state);
+	kept.push_back(sink);
+
+	//predecessors of every kept state for every class
+	vector<vector<vector<int>>> predecessors(classCount, vector<vector<int>>(n + 1));
+	for (int state : kept)
+		for (int cls = 1; cls < classCount; cls++)
+			predecessors[cls][target(state, cls)].push_back(state);
+
+	//start from the blocks of states with the same tag
+	Partition partition(n + 1);
+	map<int, vector<int>> byTag;
+	for (int state : kept)
+		byTag[state == sink ? -1 : dfa.accept[state]].push_back(state);
+
+	vector<int> worklist;
+	vector<bool> inWorklist;
+	for (const auto& tagStates : byTag) {
+		worklist.push_back(partition.blockCount());
+		inWorklist.push_back(true);
+		partition.addBlock(tagStates.second);
+	}
+
+	while (!worklist.empty()) {
+		int splitter = worklist.back();
+		worklist.pop_back();
+		inWorklist[splitter] = false;
+
+		vector<int> splitterStates;
+		for (int i = 0; i < partition.size(splitter); i++)
+			splitterStates.push_back(partition.element(splitter, i));
+
+		for (int cls = 1; cls < classCount; cls++) {
+			for (int state : splitterStates)
+				for (int source : predecessors[cls][state])
+					partition.mark(source);
+
+			for (const auto& parts : partition.split()) {
+				inWorklist.push_back(false);
+				//a block that still has to be processed needs both halves, otherwise the smaller one is enough
+				if (inWorklist[parts.first] || partition.size(parts.second) <= partition.size(parts.first)) {
+					worklist.push_back(parts.second);
+					inWorklist[parts.second] = true;
+				}
+				else {
+					worklist.push_back(parts.first);
+					inWorklist[parts.first] = true;
+				}
+			}
+		}
+	}
+
+	//every block except the one of the sink becomes a state, numbered in the order they are reached
+	DFATable minimal;
+	minimal.charClass = dfa.charClass;
+	minimal.classCount = classCount;
+
+	vector<int> blockIds(partition.blockCount(), -1);
+	int sinkBlock = partition.block(sink);
+	vector<int> order;
+	auto idOf = [&](int state) {
+		int block = partition.block(state);
+		if (block == sinkBlock)
+			return -1;
+		if (blockIds[block] < 0) {
+			blockIds[block] = static_cast<int>(order.size());
+			order.push_back(state);
+		}
+		return blockIds[block];
+	};
+
+	if (!live[dfa.initialState]) {
+		//the language is empty, keep a lone start state
+		minimal.initialState = 0;
+		minimal.stateCount = 1;
+		minimal.next.assign(classCount, -1);
+		minimal.accept.assign(1, -1);
+		return minimal;
+	}
+
+	minimal.initialState = idOf(dfa.initialState);
+	for (size_t i = 0; i < order.size(); i++)
+		for (int cls = 1; cls < classCount; cls++)
+			idOf(target(order[i], cls));
+
+	minimal.stateCount = static_cast<int>(order.size());
+	minimal.next.assign(minimal.stateCount * classCount, -1);
+	for (int i = 0; i < minimal.stateCount; i++) {
+		minimal.accept.push_back(dfa.accept[order[i]]);
+		for (int cls = 1; cls < classCount; cls++)
+			minimal.next[i * classCount + cls] = idOf(target(order[i], cls));
+	}
+
+	return minimal;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <bitset>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomata.h"
+
+// nondeterministic automaton over bytes, used to combine several automata into one DFA
+class NFA {
+public:
+    struct Edge {
+        std::bitset<256> bytes;
+        int target;
+    };
+
+    int addState(int acceptTag = -1, int priority = 0);
+    void addEdge(int from, const std::bitset<256>& bytes, int to);
+    void addEpsilon(int from, int to);
+
+    // copies a compiled DFA into this automaton, its final states accept with the given tag
+    // returns the state the copy starts from
+    int addDFA(const DFATable& dfa, int acceptTag, int priority);
+
+    // adds a chain of states reading exactly `text`, returns the state it starts from
+    int addLiteral(const std::string& text, int acceptTag, int priority);
+
+    // adds the states of a regular expression by Thompson's construction, returns the state it starts from
+    // the syntax: | alternatives, * + ? repetitions, ( ) groups, [ ] and [^ ] byte classes with ranges,
+    // . any byte but a new line, \d digits, \w word bytes, \s white space, \n \t \r, \ before anything else takes it as it is
+    // throws invalid_argument naming the position of a syntax error
+    int addRegex(std::string_view pattern, int acceptTag, int priority);
+
+    // subset construction, when a DFA state contains several accepting states
+    // the one with the lowest priority value gives the tag
+    DFATable determinize(int start) const;
+
+    int stateCount() const { return static_cast<int>(edges.size()); }
+
+private:
+    std::vector<std::vector<Edge>> edges;
+    std::vector<std::vector<int>> epsilon;
+    std::vector<int> accept;
+    std::vector<int> priorities;
+
+    void closure(std::vector<int>& stateSet) const;
+};
+
+// smallest DFA accepting the same language with the same tags, built with Hopcroft's algorithm
+// states that are unreachable or can never reach a final state are dropped (their transitions become -1)
+DFATable minimizeDFA(const DFATable& dfa);
@@ -0,0 +1,58 @@
+#include "ProgramInternalForm.h"
+using namespace std;
+
+ProgramInternalForm::ProgramInternalForm(const SourceBuffer& source) : source(source)
+{
+}
+
+void ProgramInternalForm::add(int code, int symbolId, size_t offset, size_t length)
+{
+	codes.push_back(static_cast<int16_t>(code));
+	symbolIds.push_back(symbolId);
+	offsets.push_back(offset);
+	lengths.push_back(static_cast<uint32_t>(length));
+}
+
+void ProgramInternalForm::clear()
+{
+	codes.clear();
+	symbolIds.clear();
+	offsets.clear();
+	lengths.clear();
+}
+
+void ProgramInternalForm::reserve(size_t count)
+{
+	codes.reserve(count);
+	symbolIds.reserve(count);
+	offsets.reserve(count);
+	lengths.reserve(count);
+}
+
+void ProgramInternalForm::splice(size_t begin, size_t end, const ProgramInternalForm& tokens, long long shift)
+{
+	codes.replace(begin, end, tokens.size());
+	symbolIds.replace(begin, end, tokens.size());
+	offsets.replace(begin, end, tokens.size());
+	lengths.replace(begin, end, tokens.size());
+	for (size_t i = 0; i < tokens.size(); i++) {
+		codes.set(begin + i, static_cast<int16_t>(tokens.getCode(i)));
+		symbolIds.set(begin + i, tokens.getSymbolId(i));
+		offsets.set(begin + i, tokens.getOffset(i));
+		lengths.set(begin + i, static_cast<uint32_t>(tokens.getLength(i)));
+	}
+	offsets.shiftAfterGap(shift);
+}
+
+void ProgramInternalForm::closeGap()
+{
+	codes.closeGap();
+	symbolIds.closeGap();
+	offsets.closeGap();
+	lengths.closeGap();
+}
+
+string ProgramInternalForm::getText(size_t index) const
+{
+	return source.text(getOffset(index), getLength(index));
+}
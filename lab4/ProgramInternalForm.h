@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "SourceBuffer.h"
+#include "GapColumn.h"
+
+// program internal form kept as parallel arrays
+// a token is its code, its position in the symbol table (-1 if it has none) and the span of its text
+// in the source, the text itself is only built when someone asks for it
+// the source must keep the text of every token, so it is never told to discard anything while a PIF is filled
+//
+// splice leaves the gap of the columns after the tokens it put in, like the source does after an edit,
+// and moves the offsets after it by one shift
+class ProgramInternalForm {
+public:
+    explicit ProgramInternalForm(const SourceBuffer& source);
+
+    void add(int code, int symbolId, size_t offset, size_t length);
+    void clear();
+    void reserve(size_t count);
+    // replaces the tokens [begin, end) with all of the tokens of another PIF,
+    // the offsets of the tokens after them move by shift
+    void splice(size_t begin, size_t end, const ProgramInternalForm& tokens, long long shift);
+    // moves the tokens after the gap next to the ones before it
+    void closeGap();
+
+    size_t size() const { return codes.size(); }
+    int getCode(size_t index) const { return codes.get(index); }
+    int getSymbolId(size_t index) const { return symbolIds.get(index); }
+    size_t getOffset(size_t index) const { return static_cast<size_t>(offsets.get(index)); }
+    size_t getLength(size_t index) const { return lengths.get(index); }
+    std::string getText(size_t index) const;
+    // the text in the source without copying it, only once the source has no gap in the middle of it
+    std::string_view getView(size_t index) const { return source.view(getOffset(index), getLength(index)); }
+
+private:
+    const SourceBuffer& source;
+    // the columns always have their gaps at the same place, only the offsets are shifted
+    GapColumn<int16_t> codes;
+    GapColumn<int32_t> symbolIds;
+    GapColumn<uint64_t> offsets;
+    GapColumn<uint32_t> lengths;
+};
@@ -1,239 +1,626 @@
 #include "Scanner.h"
+#include "StaticLexer.h"
+#include "LexerTables.h"
+#include "Statistics.h"
+#include "SpscRing.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 using namespace std;
 
 
-Scanner::Scanner(std::string programPath): symbolTable(100), programFile(programPath)
+Scanner::Scanner(std::string programPath): Scanner(programPath, make_shared<const LexerSpec>())
 {
-	initTokens();
+}
 
-	finiteAutomataIdentifier= FA("FA-identifier.in");
-	finiteAutomataInteger= FA("FA-integer.in");
+Scanner::Scanner(std::string programPath, std::shared_ptr<const LexerSpec> spec): spec(spec), programPath(programPath), symbolTable(100),
+	PIF(programFile), currentOffset(0), usesCounted(false), pifStale(false)
+{
+	programFile.open(programPath);
 }
 
+Scanner::Scanner(std::string programPath, std::shared_ptr<const LexerSpec> spec, std::shared_ptr<ConcurrentSymbolTable> symbols)
+	: Scanner(programPath, spec)
+{
+	sharedSymbols = symbols;
+}
 
-void Scanner::initTokens() {
-	ifstream tokensFile("token.txt");
-	string token;
-	int index = 1;
-	while (getline(tokensFile, token)) {
-		if (token == "\\n") {
-			token = "\n";
-		}
-		if (index <= 11) {
-			this->tokens.insert({ token,{"operator", index}});
-		}
-		else if (index <= 22) {
-			this->tokens.insert({ token,{"separator", index} });
-		}
-		else {
-			this->tokens.insert({ token,{"reserved word", index} });
-		}
-		index++;
+
+void Scanner::writePIFEntry(std::ostream& file, std::string_view token, int symbolId, int code)
+{
+	if (token == "\t") {
+		token = "TAB";
+	}
+	if (token == " ") {
+		token = "SPACE";
 	}
+	if (token == "\n") {
+		token = "NEW_LINE";
+	}
+	file << "(" << token << ")" << "->(" << symbolId << ")" << " | " << code << '\n';
+}
 
-	for (auto pair : this->tokens) {
-		cout << "Token: " << pair.first << " -> type: " << pair.second.first << ", code: " << pair.second.second << endl;
+void Scanner::generatePIFFile(const std::string& path)
+{
+	ofstream file(path);
+
+	//with the text in one piece every token can be written straight from the source
+	programFile.closeGap();
+	for (size_t i = 0; i < PIF.size(); i++) {
+		writePIFEntry(file, PIF.getView(i), PIF.getSymbolId(i), PIF.getCode(i));
 	}
 }
 
-int Scanner::getTokenCode(std::string token)
+void Scanner::streamPIFFile(const std::string& path)
 {
-	auto res = tokens.find(token);
-	if (res != tokens.end())
-		return res->second.second;
-	if (this->isIdentifier(token))
-		return 37;
-	if (this->isConstant(token)) {
-		return 38;
+	ofstream file(path);
+
+	Token token;
+	while (nextToken(token)) {
+		writePIFEntry(file, getView(token), token.symbolId, token.code);
+
+		//nothing refers back to the text we already wrote
+		programFile.discardBefore(currentOffset);
 	}
-	//throw exception
 }
 
+// a block of the program on its way from the reader to the lexer
+struct ReadBlock {
+	vector<char> bytes;
+	size_t size;
+};
+
+// tokens on their way from the lexer to the writer, with their text, which the lexer forgets right away
+struct TokenBatch {
+	vector<int> codes;
+	vector<int> symbolIds;
+	// where the text of every token ends in text
+	vector<size_t> ends;
+	string text;
+
+	void clear() {
+		codes.clear();
+		symbolIds.clear();
+		ends.clear();
+		text.clear();
+	}
+};
 
-bool Scanner::processToken(std::string tokenToProcess)
+void Scanner::scanPipelined(const std::string& pifPath, const std::string& stPath)
 {
-	currToken = tokenToProcess;
+	const size_t BLOCKS_IN_FLIGHT = 4;
+	const size_t BATCHES_IN_FLIGHT = 8;
+	const size_t BATCH_SIZE = 4096;
 
-	if (isSeparatorOperatorReservedWord(tokenToProcess)) {
-		genPIF(tokenToProcess, { -1, -1 }, this->getTokenCode(tokenToProcess));
+	if (currentOffset != 0) {
+		throw logic_error("A pipelined scan has to start at the beginning of the program");
 	}
-	
-	//it means it's an identifier or constant
-	else {
-		//check if it's identifier or constant
-		if (isIdentifier(tokenToProcess)) {
-			if(!symbolTable.exists(tokenToProcess)){
-				symbolTable.insert(tokenToProcess);
+	if (!programFile.isOpen()) {
+		throw runtime_error("Could not open " + programPath);
+	}
+
+	//every ring has one thread putting items in and one taking them out, the free rings bring buffers back
+	SpscRing<ReadBlock> readBlocks(BLOCKS_IN_FLIGHT);
+	SpscRing<ReadBlock> freeBlocks(BLOCKS_IN_FLIGHT);
+	SpscRing<TokenBatch> batches(BATCHES_IN_FLIGHT);
+	SpscRing<TokenBatch> freeBatches(BATCHES_IN_FLIGHT);
+	for (size_t i = 0; i < BLOCKS_IN_FLIGHT; i++) {
+		ReadBlock block{ vector<char>(SourceBuffer::BLOCK_SIZE), 0 };
+		freeBlocks.tryPush(block);
+	}
+
+	//the reader reads the file itself even if it could be mapped, so the reading is what runs beside the lexer
+	thread reader([&]() {
+		ifstream file(programPath, ios::binary);
+		ReadBlock block;
+		while (freeBlocks.pop(block)) {
+			file.read(block.bytes.data(), block.bytes.size());
+			block.size = static_cast<size_t>(file.gcount());
+			bool last = block.size < block.bytes.size();
+			if (!readBlocks.push(block) || last) {
+				break;
 			}
-			
-			tuple<int, int> pos = symbolTable.searchElem(tokenToProcess);
-			genPIF(tokenToProcess, pos, getTokenCode(tokenToProcess));
-			
-		}
-		else if (isConstant(tokenToProcess)) {
-			if (!symbolTable.exists(tokenToProcess)) {
-				symbolTable.insert(tokenToProcess);
+		}
+		readBlocks.close();
+	});
+
+	//the symbol table is only complete once the lexer is done, it closes the ring after setting lexed
+	bool lexed = false;
+	thread writer([&]() {
+		ofstream file(pifPath);
+		TokenBatch batch;
+		while (batches.pop(batch)) {
+			size_t start = 0;
+			string_view text = batch.text;
+			for (size_t i = 0; i < batch.codes.size(); i++) {
+				writePIFEntry(file, text.substr(start, batch.ends[i] - start), batch.symbolIds[i], batch.codes[i]);
+				start = batch.ends[i];
 			}
-			tuple<int, int> pos = symbolTable.searchElem(tokenToProcess);
-			genPIF(tokenToProcess, pos, getTokenCode(tokenToProcess));
-			
+			batch.clear();
+			freeBatches.tryPush(batch);
 		}
-		else {
-			string msg = "Line " + to_string(currentLineNum) + ": " + currToken + " is lexically incorrect";
-			throw LexicalException(msg);
+		if (lexed) {
+			generateSTFile(stPath);
 		}
+	});
 
+	programFile.open([&](char* buffer, size_t capacity) -> size_t {
+		ReadBlock block;
+		if (!readBlocks.pop(block)) {
+			return 0;
+		}
+		size_t count = min(block.size, capacity);
+		memcpy(buffer, block.bytes.data(), count);
+		freeBlocks.push(block);
+		return count;
+	});
+	//the callback reads from the rings of this call, the buffer must not call it anymore once they are gone
+	struct ReaderGuard {
+		SourceBuffer& source;
+		~ReaderGuard() { source.detachReader(); }
+	} readerGuard{ programFile };
+
+	TokenBatch batch;
+	try {
+		STATS_PHASE(Scan);
+		Token token;
+		while (nextToken(token)) {
+			batch.codes.push_back(token.code);
+			batch.symbolIds.push_back(token.symbolId);
+			batch.text.append(programFile.at(token.offset), token.length);
+			batch.ends.push_back(batch.text.size());
+			programFile.discardBefore(currentOffset);
+
+			if (batch.codes.size() == BATCH_SIZE) {
+				batches.push(batch);
+				if (!freeBatches.tryPop(batch)) {
+					batch = TokenBatch();
+				}
+			}
+		}
+		STATS_ONLY(recordSymbolStatistics());
 	}
-	return false;
+	catch (...) {
+		//the writer still gets the tokens before the error, like streamPIFFile writes them, the reader stops at its next wait
+		if (!batch.codes.empty()) {
+			batches.push(batch);
+		}
+		readBlocks.close();
+		freeBlocks.close();
+		batches.close();
+		reader.join();
+		writer.join();
+		throw;
+	}
+	if (!batch.codes.empty()) {
+		batches.push(batch);
+	}
+	lexed = true;
+	batches.close();
+	reader.join();
+	writer.join();
 }
 
-void Scanner::genPIF(std::string token, tuple<int, int> pos, int code)
+void Scanner::generateSTFile(const std::string& path)
+
 {
-	if (token == "\t") {
-		token = "TAB";
-	}
-	if(token == " "){
-		token = "SPACE";
+	ofstream file(path);
+	file << (sharedSymbols ? sharedSymbols->display() : symbolTable.display());
+}
+
+int Scanner::intern(const char* data, size_t length)
+{
+	return sharedSymbols ? sharedSymbols->findOrInsert(data, length) : symbolTable.findOrInsert(data, length);
+}
+
+int Scanner::symbolCount() const
+{
+	return sharedSymbols ? sharedSymbols->size() : symbolTable.size();
+}
+
+void Scanner::recordSymbolStatistics() const
+{
+	if (sharedSymbols) {
+		sharedSymbols->recordStatistics();
 	}
-	if (token == "\n") {
-		token = "NEW_LINE";
+	else {
+		symbolTable.recordStatistics();
 	}
-	PIF.push_back({ token, pos, code });
 }
 
-bool Scanner::isSeparatorOperatorReservedWord(std::string token)
+
+
+#ifdef LAB4_STATISTICS
+static void countToken(const LexerSpec& spec, int code)
 {
-	return tokens.find(token) != tokens.end();
+	if (code == LexerSpec::IDENTIFIER_CODE) {
+		STATS_ADD(IdentifierTokens, 1);
+		return;
+	}
+	if (code == LexerSpec::CONSTANT_CODE) {
+		STATS_ADD(ConstantTokens, 1);
+		return;
+	}
+	//the other codes are numbered in the order of token.txt, like the entries of the token table
+	switch (spec.getTokens().getEntry(code - 1).category) {
+	case TokenCategory::Operator:
+		STATS_ADD(OperatorTokens, 1);
+		break;
+	case TokenCategory::Separator:
+		STATS_ADD(SeparatorTokens, 1);
+		break;
+	default:
+		STATS_ADD(ReservedWordTokens, 1);
+		break;
+	}
 }
+#endif
 
-bool Scanner::isSeparator(std::string token)
+void Scanner::scan()
 {
-	auto res = tokens.find(token);
-	return res != tokens.end() && res->second.first == "separator";
+	STATS_PHASE(Scan);
+	Token token;
+	while (nextToken(token)) {
+		PIF.add(token.code, token.symbolId, token.offset, token.length);
+	}
+	STATS_ONLY(recordSymbolStatistics());
 }
 
-bool Scanner::isOperator(std::string token)
+void Scanner::countSymbolUses()
 {
-	auto res = tokens.find(token);
-	return res != tokens.end() && res->second.first == "operator";
+	symbolUses.assign(symbolCount(), 0);
+	for (size_t i = 0; i < PIF.size(); i++) {
+		int id = PIF.getSymbolId(i);
+		if (id >= 0) {
+			symbolUses[id]++;
+		}
+	}
+	usesCounted = true;
 }
 
-bool Scanner::isReservedWord(std::string token)
+void Scanner::rescan()
 {
-	auto res = tokens.find(token);
-	return res != tokens.end() && res->second.first == "reserved word";
+	PIF.clear();
+	symbolTable = HashTable(100);
+	currentOffset = 0;
+	lines.clear();
+	usesCounted = false;
+	pifStale = true;
+	scan();
+	pifStale = false;
 }
 
-bool Scanner::isConstant(std::string token)
+void Scanner::applyEdit(size_t offset, size_t removed, const std::string& inserted)
 {
-   std::regex integerRegex(R"(^[-+]?[0-9]+$)");
-   std::regex booleanRegex(R"(^(true|false)$)");
-   std::regex stringRegex(R"(^\".*\"$)");
+	STATS_PHASE(ApplyEdit);
+	bool scannedAll = currentOffset == programFile.size() && programFile.atEnd();
+
+	//no token goes over a new line, so lexing can start again right after the last one before the edit
+	size_t first = 0;
+	size_t remaining = PIF.size();
+	while (remaining > 0) {
+		size_t half = remaining / 2;
+		if (PIF.getOffset(first + half) < offset) {
+			first += half + 1;
+			remaining -= half + 1;
+		}
+		else {
+			remaining = half;
+		}
+	}
+	while (first > 0 && *programFile.at(PIF.getOffset(first - 1)) != '\n') {
+		first--;
+	}
+	size_t restart = first > 0 ? PIF.getOffset(first - 1) + 1 : 0;
 
+	if (!programFile.edit(offset, removed, inserted)) {
+		throw out_of_range("The edit is outside of the program");
+	}
+	long long shift = static_cast<long long>(inserted.size()) - static_cast<long long>(removed);
+	if (pifStale || !scannedAll) {
+		rescan();
+		return;
+	}
+	lines.edit(offset, removed, inserted);
+	if (!usesCounted) {
+		countSymbolUses();
+	}
 
-   if (finiteAutomataInteger.checkIfConsistent(token)) {
-	   return true;
-   }
-   if (regex_match(token, integerRegex)) {
-	   return true;
-   }
-   if (regex_match(token, booleanRegex)) {
-	   return true;
-   }
-   if (regex_match(token, stringRegex)) {
-	   return true;
-   }
-   return false;
+	//an old token that starts after the removed text lines up when a new token starts where it moved to,
+	//the text from there on is the same so the rest of the tokens are too
+	size_t oldEnd = offset + removed;
+	size_t newEnd = offset + inserted.size();
+	size_t last = first;
+	ProgramInternalForm tokens(programFile);
+	size_t curr = restart;
+	try {
+		while (curr < programFile.size()) {
+			if (curr >= newEnd) {
+				while (last < PIF.size() && (PIF.getOffset(last) < oldEnd || PIF.getOffset(last) + shift < curr)) {
+					last++;
+				}
+				if (last < PIF.size() && PIF.getOffset(last) + shift == curr) {
+					break;
+				}
+			}
+
+			int code = 0;
+			size_t length = matchToken(curr, code);
+			if (code != 0) {
+				int pos = -1;
+				if (code == IDENTIFIER_CODE || code == CONSTANT_CODE) {
+					pos = intern(programFile.at(curr), length);
+					if (pos >= static_cast<int>(symbolUses.size())) {
+						symbolUses.resize(pos + 1, 0);
+					}
+					symbolUses[pos]++;
+				}
+				tokens.add(code, pos, curr, length);
+				STATS_ONLY(countToken(*spec, code));
+			}
+			curr += length;
+		}
+	}
+	catch (const LexicalException&) {
+		pifStale = true;
+		throw;
+	}
+	if (curr >= programFile.size()) {
+		last = PIF.size();
+	}
+
+	//the symbols of the tokens that were lexed again and are not in the new ones anymore go away
+	for (size_t i = first; i < last; i++) {
+		int pos = PIF.getSymbolId(i);
+		//other scanners may still refer to a shared symbol
+		if (pos >= 0 && --symbolUses[pos] == 0 && !sharedSymbols) {
+			symbolTable.remove(symbolTable.getSymbolView(pos));
+		}
+	}
+	PIF.splice(first, last, tokens, shift);
+	currentOffset = programFile.size();
+	STATS_ONLY(recordSymbolStatistics());
 }
 
+std::string Scanner::getText(const Token& token) const
+{
+	return programFile.text(token.offset, token.length);
+}
 
-bool Scanner::isIdentifier(std::string token)
+size_t Scanner::matchToken(size_t offset, int& code)
 {
+	//the generated tables are compiled into the matching loop, loaded ones are read through the spec
+	if (spec->usesGeneratedTables()) {
+		return matchTokenWith(StaticLexer<LexerTables>(), offset, code);
+	}
+	return matchTokenWith(*spec, offset, code);
+}
 
-	return finiteAutomataIdentifier.checkIfConsistent(token);
-	std::regex identifierRegex(R"(^[a-zA-Z][a-zA-Z0-9]*$)");
+template <class Lexer>
+size_t Scanner::matchTokenWith(const Lexer& lexer, size_t offset, int& code)
+{
+	const ByteClassifier& ignored = spec->getIgnoredClassifier();
+	for (;;) {
+		const char* begin = programFile.at(offset);
+		const char* end = begin + programFile.contiguous(offset);
+
+		//tabs and the carriage returns of windows line endings are not tokens, a whole run of them is skipped
+		if (ignored.contains(*begin)) {
+			code = 0;
+			size_t skipped = ignored.findFirstNotIn(begin, end);
+			STATS_ADD(SkippedBytes, skipped);
+			return skipped;
+		}
 
-	if (regex_match(token, identifierRegex)) {
-		return true;
+		//a token that doesn't start with a delimiter is the run of bytes up to the next one, which is found
+		//a vector at a time, the automaton then only has to confirm it and never runs past the token
+		unsigned char first = static_cast<unsigned char>(*begin);
+		bool reachedEnd = false;
+		if (spec->tokensEndAtDelimiters() && !lexer.isDelimiter(first)) {
+			size_t run = 1 + spec->getDelimiterClassifier().findFirstIn(begin + 1, end);
+			if (begin + run == end) {
+				if (programFile.extend(offset)) {
+					STATS_ADD(TokenRestarts, 1);
+					continue;
+				}
+				//extend may have moved the text even when there was nothing more to read
+				begin = programFile.at(offset);
+			}
+			if (lexer.match(begin, begin + run, code, reachedEnd) != run) {
+				throw lexicalError(offset, offset + run);
+			}
+			STATS_ADD(DelimiterRunTokens, 1);
+			return run;
+		}
+
+		size_t length = lexer.match(begin, end, code, reachedEnd);
+
+		//the token may go on in the next block or after the gap, match it again once that is read
+		if (reachedEnd && programFile.extend(offset)) {
+			STATS_ADD(TokenRestarts, 1);
+			continue;
+		}
+
+		//a token that doesn't start with a separator has to end right before one
+		int next = programFile.peek(offset + length);
+		bool separated = lexer.isDelimiter(first) || next < 0 || lexer.isDelimiter(next);
+
+		if (length == 0 || !separated) {
+			size_t stop = offset + 1;
+			for (int ch = programFile.peek(stop); ch >= 0 && !lexer.isDelimiter(ch); ch = programFile.peek(++stop)) {
+			}
+			throw lexicalError(offset, stop);
+		}
+
+		STATS_ADD(AutomatonTokens, 1);
+		return length;
 	}
-	return false;
 }
 
-void Scanner::generatePIFFile()
+LexicalException Scanner::lexicalError(size_t offset, size_t stop) const
 {
-	ofstream file("PIF.out");
+	//the line of offset is in the table by now, the new line before it was a token of its own
+	SourcePosition position = lines.find(offset);
+	string token = programFile.text(offset, stop - offset);
+	string msg = "Line " + to_string(position.line) + ", column " + to_string(position.column) + ": " + token + " is lexically incorrect";
+	return LexicalException(msg);
+}
 
-	auto it = this->PIF.begin();
-	while (it != PIF.end()) {
-		file << "(" << get<0>(*it) << ")" << "->(" << get<0>(get<1>(*it)) << "," << get<1>(get<1>(*it)) << ")" << " | " <<get<2>(*it) << endl;
-		it++;
+bool Scanner::nextToken(Token& token)
+{
+	if (!programFile.isOpen()) {
+		throw runtime_error("Could not open " + programPath);
 	}
-}
 
-void Scanner::generateSTFile()
+	while (currentOffset < programFile.size() || programFile.fill()) {
+		size_t curr = currentOffset;
+		int code = 0;
+		size_t length = matchToken(curr, code);
 
+		if (code == 0) {
+			currentOffset += length;
+			continue;
+		}
+
+		STATS_ONLY(countToken(*spec, code));
+		token.code = code;
+		token.offset = curr;
+		token.length = length;
+		token.line = lines.lineCount();
+
+		//the lexer already classified the token, only identifiers and constants go to the symbol table
+		token.symbolId = -1;
+		if (code == IDENTIFIER_CODE || code == CONSTANT_CODE) {
+			token.symbolId = intern(programFile.at(curr), length);
+		}
+
+		if (*programFile.at(curr) == '\n') {
+			lines.addNewLine(curr);
+		}
+		currentOffset += length;
+		return true;
+	}
+
+	return false;
+}
+
+Scanner::ScanChunk::ScanChunk(const SourceBuffer& source, size_t begin, size_t end)
+	: begin(begin), end(end), symbolTable(100), PIF(source), failed(false), errorOffset(0)
 {
-	ofstream file("STF.out");
-	file << symbolTable.display();
 }
 
+void Scanner::scanChunk(ScanChunk& chunk)
+{
+	STATS_PHASE(ScanChunk);
+	size_t curr = chunk.begin;
+	try {
+		while (curr < chunk.end) {
+			int code = 0;
+			size_t length = matchToken(curr, code);
+			if (code == 0) {
+				curr += length;
+				continue;
+			}
 
+			int pos = -1;
+			if (code == IDENTIFIER_CODE || code == CONSTANT_CODE) {
+				//a shared table takes the symbols of every thread directly, the chunk's own stays empty
+				pos = sharedSymbols ? sharedSymbols->findOrInsert(programFile.at(curr), length)
+					: chunk.symbolTable.findOrInsert(programFile.at(curr), length);
+			}
+			chunk.PIF.add(code, pos, curr, length);
+			STATS_ONLY(countToken(*spec, code));
+			curr += length;
+		}
+	}
+	catch (const LexicalException&) {
+		//the line in the message is not known here, the error is raised again once the chunks are merged
+		chunk.failed = true;
+		chunk.errorOffset = curr;
+	}
+}
 
-void Scanner::scan()
+void Scanner::scanParallel(unsigned threadCount)
 {
-	if (!programFile) {
-		//throw exception here
+	//chunks smaller than this are not worth a thread
+	const size_t MIN_CHUNK_SIZE = 1 << 16;
+
+	//every thread reads the whole program, so all of it has to be in memory first
+	while (programFile.fill()) {
 	}
-	char currCharacter;
-	string buffer;
-	currentLineNum = 1;
-	currentCharNumPerLine = 1;
-	while (programFile.get(currCharacter)) {
-		if (currCharacter == '\t') {
-			continue;
-		}
-		string currStringChar(1, currCharacter);
+	programFile.closeGap();
+	size_t begin = currentOffset;
+	size_t size = programFile.size() - begin;
 
-		if (currCharacter == '<') {
-			programFile.get(currCharacter);
-			if (currCharacter == '<') {
-				if (!buffer.empty())
-				{
-					processToken(buffer);
-					buffer.clear();
-				}
-				processToken("<<");
+	if (threadCount == 0) {
+		threadCount = 1;
+	}
+	size_t chunkCount = min<size_t>(threadCount * 4, size / MIN_CHUNK_SIZE);
+	if (threadCount == 1 || chunkCount < 2) {
+		scan();
+		return;
+	}
+	STATS_PHASE(Scan);
+
+	//no token goes over a new line, so a chunk can end right after any of them
+	vector<ScanChunk> chunks;
+	chunks.reserve(chunkCount);
+	const char* data = programFile.at(begin);
+	size_t chunkBegin = 0;
+	for (size_t i = 1; i <= chunkCount && chunkBegin < size; i++) {
+		size_t chunkEnd = size;
+		if (i < chunkCount) {
+			size_t target = max(chunkBegin, size / chunkCount * i);
+			const void* newLine = memchr(data + target, '\n', size - target);
+			if (newLine != nullptr) {
+				chunkEnd = static_cast<const char*>(newLine) - data + 1;
 			}
 		}
+		chunks.emplace_back(programFile, begin + chunkBegin, begin + chunkEnd);
+		chunkBegin = chunkEnd;
+	}
 
-		else if (currCharacter == '>') {
-			programFile.get(currCharacter);
-			if (currCharacter == '>') {
-				if (!buffer.empty())
-				{
-					processToken(buffer);
-					buffer.clear();
-				}
-				processToken(">>");
+	//threads take the next chunk that nobody has started yet, so uneven chunks balance out
+	atomic<size_t> nextChunk(0);
+	vector<thread> workers;
+	for (unsigned i = 0; i < threadCount && i < chunks.size(); i++) {
+		workers.emplace_back([&]() {
+			for (size_t index = nextChunk++; index < chunks.size(); index = nextChunk++) {
+				scanChunk(chunks[index]);
 			}
+		});
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	//merging in order gives every symbol the position a sequential scan would have given it,
+	//with a shared table the positions are already the final ones
+	for (ScanChunk& chunk : chunks) {
+		vector<int> positions(chunk.symbolTable.size());
+		for (int id = 0; id < chunk.symbolTable.size(); id++) {
+			positions[id] = symbolTable.findOrInsert(chunk.symbolTable.getSymbolData(id), chunk.symbolTable.getSymbolLength(id));
 		}
 
-		else if (isSeparator(currStringChar)) {
-			if (currCharacter == '\n') {
-				currentLineNum++;
-				currentCharNumPerLine = 1;
-			}
-			if (!buffer.empty())
-			{
-				processToken(buffer);
-				buffer.clear();
+		PIF.reserve(PIF.size() + chunk.PIF.size());
+		for (size_t i = 0; i < chunk.PIF.size(); i++) {
+			int pos = chunk.PIF.getSymbolId(i);
+			if (pos >= 0 && !sharedSymbols) {
+				pos = positions[pos];
 			}
-			processToken(currStringChar);
+			PIF.add(chunk.PIF.getCode(i), pos, chunk.PIF.getOffset(i), chunk.PIF.getLength(i));
 		}
-		else {
-			buffer += currCharacter;
+
+		//every new line is a token, so the lines are found straight in the text instead of token by token
+		size_t lexed = chunk.failed ? chunk.errorOffset : chunk.end;
+		lines.addNewLines(programFile.at(chunk.begin), lexed - chunk.begin, chunk.begin);
+
+		if (chunk.failed) {
+			currentOffset = chunk.errorOffset;
+			int code = 0;
+			matchToken(currentOffset, code);
 		}
-		currentCharNumPerLine++;
+		currentOffset = chunk.end;
 	}
-
+	STATS_ONLY(recordSymbolStatistics());
 }
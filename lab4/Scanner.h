@@ -2,44 +2,115 @@
 #include <string>
 #include <fstream>
 #include <vector>
-#include <tuple>
-#include <unordered_map>
-#include <regex>
+#include <memory>
+#include <thread>
 #include "HashTable.h"
-#include "FiniteAutomata.h"
+#include "ConcurrentSymbolTable.h"
+#include "LexerSpec.h"
+#include "SourceBuffer.h"
+#include "ProgramInternalForm.h"
+#include "LineTable.h"
 #include "LexicalException.cpp"
 
+// one token of the program, offset and length locate its text in the source
+struct Token {
+	int code;
+	int symbolId;
+	size_t offset;
+	size_t length;
+	int line;
+};
+
 class Scanner {
 public:
 	Scanner(std::string programPath);
-	Scanner(std::ifstream programFile);
+	// scanners of many files can share the spec instead of loading it again
+	Scanner(std::string programPath, std::shared_ptr<const LexerSpec> spec);
+	// identifiers and constants go to a table that scanners on other threads may be filling at the same time,
+	// the symbol ids in the PIF are the ones of that table and the ST file is all of it
+	// symbols are never removed from it, an edit only stops referring to them
+	Scanner(std::string programPath, std::shared_ptr<const LexerSpec> spec, std::shared_ptr<ConcurrentSymbolTable> symbols);
+
+	// reads the next token, returns false at the end of the program, throws runtime_error if the program could not be opened
+	// identifiers and constants are added to the symbol table as they are read
+	bool nextToken(Token& token);
+	std::string getText(const Token& token) const;
+	// the text of the token that was just read, without copying it, valid until the next one is read
+	std::string_view getView(const Token& token) const { return programFile.view(token.offset, token.length); }
+
 	void scan();
-	void generateSTFile();
-	void generatePIFFile();
+	// same result as scan(), the program is split at new lines and the pieces are lexed on several threads
+	void scanParallel(unsigned threadCount = std::thread::hardware_concurrency());
+	void generateSTFile(const std::string& path = "STF.out");
+	void generatePIFFile(const std::string& path = "PIF.out");
+	// scans the rest of the program writing the PIF token by token, without keeping it in memory
+	void streamPIFFile(const std::string& path = "PIF.out");
+	// scan() with generatePIFFile and generateSTFile in three stages on their own threads: one reads the file,
+	// the calling thread lexes it and one writes the files, blocks and batches of tokens go between them over
+	// lock-free rings, so reading and writing happen while the lexer runs
+	// the PIF is not kept in memory, like with streamPIFFile, and the scan has to start at the beginning of the program
+	void scanPipelined(const std::string& pifPath = "PIF.out", const std::string& stPath = "STF.out");
+
+	// replaces removed bytes at offset with inserted in the program and brings the PIF and the symbol table up to date
+	// only the line the edit starts on is lexed again, up to where the new tokens line up with the old ones,
+	// the tokens after that keep their symbol ids and just move, symbols nothing refers to anymore are removed
+	// throws a LexicalException if the edit leaves an incorrect token, the next edit then scans the whole program
+	void applyEdit(size_t offset, size_t removed, const std::string& inserted);
+
+	const ProgramInternalForm& getPIF() const { return PIF; }
+	// line and column of an offset in the program, such as that of a PIF entry, as far as it was scanned
+	SourcePosition getPosition(size_t offset) const { return lines.find(offset); }
+	const LineTable& getLines() const { return lines; }
+	const LexerSpec& getSpec() const { return *spec; }
+
+	static const int IDENTIFIER_CODE = LexerSpec::IDENTIFIER_CODE;
+	static const int CONSTANT_CODE = LexerSpec::CONSTANT_CODE;
 
 private:
-	std::ifstream programFile;
+	std::shared_ptr<const LexerSpec> spec;
+	std::string programPath;
+	SourceBuffer programFile;
 	HashTable symbolTable;
-	FA finiteAutomataInteger;
-	FA finiteAutomataIdentifier;
-	std::vector<std::tuple<std::string, std::tuple<int,int>, int>> PIF;
-
-
-	std::unordered_map<std::string, std::pair<std::string, int>> tokens;
-	int currentLineNum;
-	int currentCharNumPerLine;
-	std::string currToken;
-
-	bool processToken(std::string tokenToProcess);
-	void genPIF(std::string token, std::tuple<int, int> pos, int code);
-	bool isSeparatorOperatorReservedWord(std::string token);
-	bool isSeparator(std::string token);
-	bool isOperator(std::string token);
-	bool isReservedWord(std::string token);
-	bool isConstant(std::string token);
-	bool isIdentifier(std::string token);
-	void initTokens();
-	std::string getTokenType(std::string token);
-	int getTokenCode(std::string token);
+	// null unless the symbols go to a shared table, symbolTable stays empty then
+	std::shared_ptr<ConcurrentSymbolTable> sharedSymbols;
+	ProgramInternalForm PIF;
+
+	size_t currentOffset;
+	// the start of every line scanned so far, kept up to date by applyEdit
+	LineTable lines;
+
+	// how many PIF entries refer to each symbol id, counted on the first edit
+	std::vector<int> symbolUses;
+	bool usesCounted;
+	// the PIF doesn't match the program after an edit that failed
+	bool pifStale;
+	void countSymbolUses();
+	void rescan();
+	int intern(const char* data, size_t length);
+	int symbolCount() const;
+	void recordSymbolStatistics() const;
+
+	// part of the program lexed by one thread, with its own PIF and symbol table
+	struct ScanChunk {
+		size_t begin;
+		size_t end;
+		HashTable symbolTable;
+		ProgramInternalForm PIF;
+		bool failed;
+		size_t errorOffset;
+
+		ScanChunk(const SourceBuffer& source, size_t begin, size_t end);
+	};
+
+	// length of the token at offset, for characters that are skipped (tabs, carriage returns) code is 0
+	// and the length is that of the whole run of them
+	// throws a LexicalException with the line and column of offset if there is no correct token there
+	size_t matchToken(size_t offset, int& code);
+	template <class Lexer>
+	size_t matchTokenWith(const Lexer& lexer, size_t offset, int& code);
+	LexicalException lexicalError(size_t offset, size_t stop) const;
+	void scanChunk(ScanChunk& chunk);
+
+	static void writePIFEntry(std::ostream& file, std::string_view token, int symbolId, int code);
 
 };
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "SourceBuffer.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+using namespace std;
+
+SourceBuffer::SourceBuffer() : opened(false), mapped(nullptr), base(0), filled(0), ended(true), gapStart(NO_GAP), gapSize(0)
+{
+#ifdef _WIN32
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+#endif
+}
+
+SourceBuffer::~SourceBuffer()
+{
+	close();
+}
+
+bool SourceBuffer::open(const string& path)
+{
+	close();
+
+	if (map(path)) {
+		STATS_ADD(BytesRead, filled);
+		opened = true;
+		ended = true;
+		return true;
+	}
+
+	//not something we can map, read it block by block instead
+	stream.open(path, ios::binary);
+	if (!stream.is_open())
+		return false;
+
+	opened = true;
+	ended = false;
+	return true;
+}
+
+bool SourceBuffer::open(function<size_t(char* buffer, size_t capacity)> read)
+{
+	close();
+	reader = read;
+	opened = true;
+	ended = false;
+	return true;
+}
+
+void SourceBuffer::close()
+{
+	unmap();
+
+	if (stream.is_open())
+		stream.close();
+	stream.clear();
+	reader = nullptr;
+	blocks.clear();
+	base = 0;
+	filled = 0;
+	ended = true;
+	opened = false;
+	gapStart = NO_GAP;
+	gapSize = 0;
+}
+
+void SourceBuffer::detachReader()
+{
+	reader = nullptr;
+	ended = true;
+}
+
+void SourceBuffer::unmap()
+{
+#ifdef _WIN32
+	if (mapped != nullptr)
+		UnmapViewOfFile(mapped);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle(fileHandle);
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+#else
+	if (mapped != nullptr)
+		munmap(const_cast<char*>(mapped), filled);
+#endif
+	mapped = nullptr;
+}
+
+bool SourceBuffer::map(const string& path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	mapped = static_cast<const char*>(view);
+	filled = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	//empty files can't be mapped, they take the block path and end right away
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED)
+		return false;
+	madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+	mapped = static_cast<const char*>(view);
+	filled = static_cast<size_t>(info.st_size);
+	return true;
+#endif
+}
+
+bool SourceBuffer::fill()
+{
+	if (ended)
+		return false;
+
+	//grow by whole blocks so every read lands on a block boundary of the file
+	//a block that doesn't fit is read on the side first, so the last, empty read leaves the text where it was
+	size_t used = filled - base;
+	bool fits = blocks.size() >= used + BLOCK_SIZE;
+	vector<char> side;
+	char* target = blocks.data() + used;
+	if (!fits) {
+		side.resize(BLOCK_SIZE);
+		target = side.data();
+	}
+
+	size_t count;
+	if (reader) {
+		count = reader(target, BLOCK_SIZE);
+	}
+	else {
+		stream.read(target, BLOCK_SIZE);
+		count = static_cast<size_t>(stream.gcount());
+	}
+	if (!fits && count > 0) {
+		blocks.resize(max(blocks.size() * 2, used + BLOCK_SIZE));
+		copy(side.begin(), side.begin() + count, blocks.begin() + used);
+	}
+	filled += count;
+	STATS_ADD(BytesRead, count);
+
+	if (count < BLOCK_SIZE)
+		ended = true;
+	return count > 0;
+}
+
+int SourceBuffer::peek(size_t offset)
+{
+	while (offset >= filled && fill()) {
+	}
+	return offset < filled ? static_cast<unsigned char>(*at(offset)) : -1;
+}
+
+bool SourceBuffer::extend(size_t offset)
+{
+	if (offset >= gapStart || gapStart >= filled)
+		return fill();
+
+	//no token goes over a new line, so a token that ran into the gap is whole once the gap is past the next one
+	const char* after = at(gapStart);
+	const void* newLine = memchr(after, '\n', filled - gapStart);
+	moveGap(newLine != nullptr ? gapStart + (static_cast<const char*>(newLine) - after) + 1 : filled);
+	return true;
+}
+
+void SourceBuffer::closeGap()
+{
+	if (gapStart < filled)
+		moveGap(filled);
+}
+
+void SourceBuffer::discardBefore(size_t offset)
+{
+	//compact only once at least a whole block can go, so copying stays cheap next to reading
+	if (mapped != nullptr || gapStart != NO_GAP || offset < base + BLOCK_SIZE)
+		return;
+
+	copy(blocks.begin() + (offset - base), blocks.begin() + (filled - base), blocks.begin());
+	base = offset;
+}
+
+string SourceBuffer::text(size_t offset, size_t length) const
+{
+	size_t first = min(length, contiguous(offset));
+	string result(at(offset), first);
+	if (first < length)
+		result.append(at(offset + first), length - first);
+	return result;
+}
+
+bool SourceBuffer::edit(size_t offset, size_t removed, const string& inserted)
+{
+	//the text can only change in a buffer of our own that has all of it
+	while (fill()) {
+	}
+	if (base != 0 || offset + removed > filled)
+		return false;
+
+	if (mapped != nullptr) {
+		vector<char> copied(mapped, mapped + filled);
+		unmap();
+		blocks.swap(copied);
+	}
+	if (gapStart == NO_GAP) {
+		gapStart = filled;
+		gapSize = blocks.size() - filled;
+	}
+
+	//the removed bytes join the gap and the inserted ones are taken from the start of it
+	moveGap(offset + removed);
+	gapStart = offset;
+	gapSize += removed;
+	growGap(inserted.size());
+	copy(inserted.begin(), inserted.end(), blocks.begin() + gapStart);
+	gapStart += inserted.size();
+	gapSize -= inserted.size();
+	filled = filled - removed + inserted.size();
+	return true;
+}
+
+void SourceBuffer::moveGap(size_t offset)
+{
+	char* data = blocks.data();
+	if (offset < gapStart)
+		memmove(data + offset + gapSize, data + offset, gapStart - offset);
+	else
+		memmove(data + gapStart, data + gapStart + gapSize, offset - gapStart);
+	gapStart = offset;
+}
+
+void SourceBuffer::growGap(size_t needed)
+{
+	if (gapSize >= needed)
+		return;
+
+	//growing with the size of the text keeps the copying to a constant per inserted byte
+	size_t grow = max(needed, filled / 8 + 4096) - gapSize;
+	size_t oldSize = blocks.size();
+	blocks.resize(oldSize + grow);
+	char* data = blocks.data();
+	memmove(data + gapStart + gapSize + grow, data + gapStart + gapSize, oldSize - gapStart - gapSize);
+	gapSize += grow;
+}
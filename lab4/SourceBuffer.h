@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <functional>
+
+// contiguous view of a program file
+// regular files are memory-mapped, anything that can't be mapped (pipes, devices) is read in large
+// blocks appended to one buffer, so offsets into the data stay valid while more of it is read
+// offsets are always counted from the start of the file, even after discardBefore dropped a prefix
+//
+// an edit copies the text into the block buffer and leaves a gap of unused bytes right after the inserted text,
+// the next edit only moves the bytes between the two, so the text is contiguous up to the gap and after it
+class SourceBuffer {
+public:
+    SourceBuffer();
+    ~SourceBuffer();
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    bool open(const std::string& path);
+    // the blocks come from read instead of a file, it fills up to capacity bytes and returns how many it put there,
+    // less than capacity only at the end of the input
+    bool open(std::function<size_t(char* buffer, size_t capacity)> read);
+    void close();
+    // stops calling the read callback, the input ends with what was read so far
+    void detachReader();
+    bool isOpen() const { return opened; }
+    bool isMapped() const { return mapped != nullptr; }
+
+    // bytes available so far are [0, size()), size() only grows when fill() reads another block
+    // at() stays valid until the next fill(), extend(), closeGap(), discardBefore() or edit()
+    const char* at(size_t offset) const {
+        if (mapped != nullptr)
+            return mapped + offset;
+        return blocks.data() + (offset - base) + (offset >= gapStart ? gapSize : 0);
+    }
+    size_t size() const { return filled; }
+    // how many bytes from at(offset) on can be read in one piece
+    size_t contiguous(size_t offset) const { return (offset < gapStart && gapStart < filled ? gapStart : filled) - offset; }
+    // copy of the text, in two pieces if it goes over the gap
+    std::string text(size_t offset, size_t length) const;
+    // the text without copying it, it has to be in one piece (contiguous(offset) >= length) and stays valid as long as at() does
+    std::string_view view(size_t offset, size_t length) const { return std::string_view(at(offset), length); }
+
+    // lets the block reader forget everything before offset, mapped files keep all of it
+    void discardBefore(size_t offset);
+
+    // reads the next block, returns false if nothing more could be read
+    bool fill();
+    bool atEnd() const { return ended; }
+    // makes contiguous(offset) longer, by reading the next block or by moving the gap past the next new line,
+    // returns false if it already went to the end of the input
+    bool extend(size_t offset);
+    // moves the gap after the last byte, so all of the text is in one piece
+    void closeGap();
+
+    // byte at the given offset without consuming anything, -1 past the end of the input
+    int peek(size_t offset);
+
+    // replaces removed bytes at offset with inserted, the rest of the file is read and a mapped file copied first
+    // false if that part of the text was already discarded or goes past the end
+    bool edit(size_t offset, size_t removed, const std::string& inserted);
+
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+private:
+    bool opened;
+    const char* mapped;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+    std::ifstream stream;
+    std::function<size_t(char*, size_t)> reader;
+    std::vector<char> blocks;
+    size_t base;
+    size_t filled;
+    bool ended;
+
+    static const size_t NO_GAP = static_cast<size_t>(-1);
+    size_t gapStart;
+    size_t gapSize;
+
+    bool map(const std::string& path);
+    void unmap();
+    void moveGap(size_t offset);
+    void growGap(size_t needed);
+};
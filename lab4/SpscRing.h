@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// bounded queue between exactly one producer thread and one consumer thread, without locks
+// the producer only writes tail and the consumer only writes head, each on a cache line of its own,
+// and each side keeps a copy of the other's index so it only reads the shared one when the ring looks full or empty
+// items are moved in and out, so a ring of buffers hands the buffers over without copying them
+template <class T>
+class SpscRing {
+public:
+    // capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity) : head(0), tail(0), cachedHead(0), cachedTail(0), closed(false) {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        items.resize(size);
+        mask = size - 1;
+    }
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // producer side, false if the ring is full
+    bool tryPush(T& item) {
+        size_t at = tail.load(std::memory_order_relaxed);
+        if (at - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (at - cachedHead > mask)
+                return false;
+        }
+        items[at & mask] = std::move(item);
+        tail.store(at + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, false if the ring is empty
+    bool tryPop(T& item) {
+        size_t at = head.load(std::memory_order_relaxed);
+        if (at == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (at == cachedTail)
+                return false;
+        }
+        item = std::move(items[at & mask]);
+        head.store(at + 1, std::memory_order_release);
+        return true;
+    }
+
+    // wait until there is room, false without pushing if the consumer closed the ring meanwhile
+    bool push(T& item) {
+        while (!tryPush(item)) {
+            if (isClosed())
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // wait for an item, false once the ring is closed and everything pushed before that was taken
+    bool pop(T& item) {
+        while (!tryPop(item)) {
+            if (isClosed())
+                return tryPop(item);
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // either side says it is done, the producer at the end of its items, the consumer when it gives up early
+    void close() { closed.store(true, std::memory_order_release); }
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+private:
+    std::vector<T> items;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    // the producer's copy of head and the consumer's copy of tail
+    alignas(64) size_t cachedHead;
+    alignas(64) size_t cachedTail;
+    alignas(64) std::atomic<bool> closed;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include "Statistics.h"
+
+// the lexer DFA over tables the compiler can see, Tables is a struct like the LexerTables one lexgen writes
+// it has the same match / isDelimiter interface as LexerSpec, so the scanner can be instantiated on either
+template <class Tables>
+struct StaticLexer {
+    static bool isDelimiter(unsigned char character) {
+        return Tables::delimiters[character];
+    }
+
+    static size_t match(const char* begin, const char* end, int& code, bool& reachedEnd) {
+        size_t length = 0;
+        int state = Tables::initialState;
+        reachedEnd = false;
+
+        const char* curr = begin;
+        for (;;) {
+            if (curr == end) {
+                reachedEnd = true;
+                break;
+            }
+            unsigned char character = static_cast<unsigned char>(*curr++);
+            state = Tables::next[state * Tables::classCount + Tables::charClass[character]];
+            if (state < 0)
+                break;
+
+            //remember the last accepting state we went through
+            if (Tables::accept[state] >= 0) {
+                length = curr - begin;
+                code = Tables::accept[state];
+            }
+        }
+
+        STATS_ADD(LexerTransitions, curr - begin);
+        return length;
+    }
+};
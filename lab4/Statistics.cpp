@@ -0,0 +1,146 @@
+#include "Statistics.h"
+#include <atomic>
+#include <iomanip>
+using namespace std;
+
+static const int COUNTERS = static_cast<int>(Statistics::Counter::Count);
+static const int HISTOGRAMS = static_cast<int>(Statistics::Histogram::Count);
+static const int GAUGES = static_cast<int>(Statistics::Gauge::Count);
+static const int PHASES = static_cast<int>(Statistics::Phase::Count);
+// values from the last bucket on are all counted in it
+static const int BUCKETS = 32;
+
+static const char* const COUNTER_NAMES[COUNTERS] = {
+	"bytes read", "skipped bytes", "operator tokens", "separator tokens", "reserved word tokens", "identifier tokens",
+	"constant tokens", "delimiter run tokens", "automaton tokens", "token restarts", "lexer transitions",
+	"automaton transitions", "symbol lookups", "symbol inserts", "symbol removes", "rehashes", "nullable steps",
+	"components", "set unions"
+};
+static const char* const HISTOGRAM_NAMES[HISTOGRAMS] = { "probe length", "displacement" };
+static const char* const GAUGE_NAMES[GAUGES] = { "symbol table load factor", "symbol table size" };
+static const char* const PHASE_NAMES[PHASES] = {
+	"none", "load spec", "scan", "scan chunk", "apply edit", "read grammar", "compute first", "compute follow",
+	"build ll1", "build lalr", "parse"
+};
+
+// threads of a parallel scan all count into the same cells, nothing is ordered by them so relaxed is enough
+static atomic<uint64_t> counters[PHASES][COUNTERS];
+static atomic<uint64_t> histograms[HISTOGRAMS][BUCKETS];
+static atomic<double> gauges[GAUGES];
+static atomic<uint64_t> phaseCalls[PHASES];
+static atomic<uint64_t> phaseNanoseconds[PHASES];
+static thread_local Statistics::Phase currentPhase = Statistics::Phase::None;
+
+void Statistics::add(Counter counter, uint64_t amount)
+{
+	counters[static_cast<int>(currentPhase)][static_cast<int>(counter)].fetch_add(amount, memory_order_relaxed);
+}
+
+void Statistics::record(Histogram histogram, uint64_t value)
+{
+	int bucket = value < BUCKETS ? static_cast<int>(value) : BUCKETS - 1;
+	histograms[static_cast<int>(histogram)][bucket].fetch_add(1, memory_order_relaxed);
+}
+
+void Statistics::set(Gauge gauge, double value)
+{
+	gauges[static_cast<int>(gauge)].store(value, memory_order_relaxed);
+}
+
+void Statistics::clear(Histogram histogram)
+{
+	for (atomic<uint64_t>& bucket : histograms[static_cast<int>(histogram)])
+		bucket.store(0, memory_order_relaxed);
+}
+
+Statistics::PhaseTimer::PhaseTimer(Phase phase) : phase(phase), outer(currentPhase), start(chrono::steady_clock::now())
+{
+	currentPhase = phase;
+}
+
+Statistics::PhaseTimer::~PhaseTimer()
+{
+	uint64_t elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	phaseCalls[static_cast<int>(phase)].fetch_add(1, memory_order_relaxed);
+	phaseNanoseconds[static_cast<int>(phase)].fetch_add(elapsed, memory_order_relaxed);
+	currentPhase = outer;
+}
+
+void Statistics::reset()
+{
+	for (auto& phase : counters)
+		for (atomic<uint64_t>& counter : phase)
+			counter = 0;
+	for (auto& histogram : histograms)
+		for (atomic<uint64_t>& bucket : histogram)
+			bucket = 0;
+	for (atomic<double>& gauge : gauges)
+		gauge = 0;
+	for (int phase = 0; phase < PHASES; phase++) {
+		phaseCalls[phase] = 0;
+		phaseNanoseconds[phase] = 0;
+	}
+}
+
+static void writeCounters(ostream& out, int phase, const char* indent)
+{
+	out << "{";
+	bool first = true;
+	for (int counter = 0; counter < COUNTERS; counter++) {
+		uint64_t value = 0;
+		for (int p = 0; p < PHASES; p++) {
+			if (phase < 0 || p == phase)
+				value += counters[p][counter].load(memory_order_relaxed);
+		}
+		if (value == 0)
+			continue;
+		out << (first ? "\n" : ",\n") << indent << "  \"" << COUNTER_NAMES[counter] << "\": " << value;
+		first = false;
+	}
+	out << (first ? "}" : string("\n") + indent + "}");
+}
+
+void Statistics::writeReport(ostream& out)
+{
+	if (!enabled()) {
+		out << "{ \"enabled\": false }" << endl;
+		return;
+	}
+
+	//phases that never ran and counters that stayed at 0 are left out
+	out << "{\n  \"enabled\": true,\n  \"phases\": {";
+	bool first = true;
+	for (int phase = 0; phase < PHASES; phase++) {
+		uint64_t calls = phaseCalls[phase].load(memory_order_relaxed);
+		bool counted = false;
+		for (int counter = 0; counter < COUNTERS; counter++)
+			counted = counted || counters[phase][counter].load(memory_order_relaxed) != 0;
+		if (calls == 0 && !counted)
+			continue;
+		out << (first ? "\n" : ",\n") << "    \"" << PHASE_NAMES[phase] << "\": { \"calls\": " << calls << ", \"ms\": "
+			<< fixed << setprecision(3) << phaseNanoseconds[phase].load(memory_order_relaxed) / 1e6 << ", \"counters\": ";
+		writeCounters(out, phase, "      ");
+		out << " }";
+		first = false;
+	}
+	out << "\n  },\n  \"counters\": ";
+	writeCounters(out, -1, "  ");
+
+	out << ",\n  \"histograms\": {";
+	for (int histogram = 0; histogram < HISTOGRAMS; histogram++) {
+		int used = BUCKETS;
+		while (used > 0 && histograms[histogram][used - 1].load(memory_order_relaxed) == 0)
+			used--;
+		out << (histogram > 0 ? ",\n" : "\n") << "    \"" << HISTOGRAM_NAMES[histogram] << "\": [";
+		for (int bucket = 0; bucket < used; bucket++)
+			out << (bucket > 0 ? ", " : "") << histograms[histogram][bucket].load(memory_order_relaxed);
+		out << "]";
+	}
+
+	out << "\n  },\n  \"gauges\": {";
+	for (int gauge = 0; gauge < GAUGES; gauge++) {
+		out << (gauge > 0 ? ",\n" : "\n") << "    \"" << GAUGE_NAMES[gauge] << "\": " << defaultfloat << setprecision(6)
+			<< gauges[gauge].load(memory_order_relaxed);
+	}
+	out << "\n  }\n}" << endl;
+}
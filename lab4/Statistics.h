@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+
+// counters, histograms and wall time of the phases of a run, for finding out why one is slow
+// everything is compiled in only when LAB4_STATISTICS is defined, otherwise the STATS_ macros are empty
+// and the hot paths are exactly what they would be without them, so release builds can keep the calls
+//
+// a counter is added to the innermost phase running on the thread, so the report can say how much of it
+// every phase did, histograms and gauges are for the whole run
+class Statistics {
+public:
+    enum class Counter {
+        BytesRead,
+        SkippedBytes,
+        OperatorTokens,
+        SeparatorTokens,
+        ReservedWordTokens,
+        IdentifierTokens,
+        ConstantTokens,
+        DelimiterRunTokens,     // taken as the run up to the next delimiter, the automaton only confirmed it
+        AutomatonTokens,        // matched by running the lexer automaton as far as it goes
+        TokenRestarts,          // matched again because the token went on in the next block or after the edit gap
+        LexerTransitions,
+        AutomatonTransitions,   // FA::checkIfConsistent
+        SymbolLookups,
+        SymbolInserts,
+        SymbolRemoves,
+        Rehashes,
+        NullableSteps,          // symbols taken off the worklist that finds the ones deriving "e"
+        Components,             // strongly connected components the set equations were solved over
+        SetUnions,
+        Count
+    };
+
+    // bucket i counts the value i, the last bucket also every value past it
+    enum class Histogram {
+        ProbeLength,            // slots a symbol table lookup looked at past the home slot
+        Displacement,           // distance of every stored symbol from its home slot, a robin hood table's chains
+        Count
+    };
+
+    enum class Gauge {
+        SymbolTableLoadFactor,
+        SymbolTableSize,
+        Count
+    };
+
+    enum class Phase {
+        None,
+        LoadSpec,
+        Scan,
+        ScanChunk,
+        ApplyEdit,
+        ReadGrammar,
+        ComputeFirst,
+        ComputeFollow,
+        BuildLL1,
+        BuildLALR,
+        Parse,
+        Count
+    };
+
+    static constexpr bool enabled() {
+#ifdef LAB4_STATISTICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static void add(Counter counter, uint64_t amount);
+    static void record(Histogram histogram, uint64_t value);
+    static void set(Gauge gauge, double value);
+    // for histograms of a snapshot, that are recorded again from scratch
+    static void clear(Histogram histogram);
+
+    // times a phase from construction to destruction, phases nest and the time of an inner one
+    // is also part of the outer one
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(Phase phase);
+        ~PhaseTimer();
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        Phase phase;
+        Phase outer;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static void reset();
+    // everything recorded since the start of the program or the last reset, as one JSON object
+    static void writeReport(std::ostream& out);
+};
+
+#ifdef LAB4_STATISTICS
+#define STATS_ADD(counter, amount) Statistics::add(Statistics::Counter::counter, amount)
+#define STATS_RECORD(histogram, value) Statistics::record(Statistics::Histogram::histogram, value)
+#define STATS_SET(gauge, value) Statistics::set(Statistics::Gauge::gauge, value)
+#define STATS_PHASE(phase) Statistics::PhaseTimer statsPhaseTimer(Statistics::Phase::phase)
+#define STATS_ONLY(statement) statement
+#else
+#define STATS_ADD(counter, amount) ((void)0)
+#define STATS_RECORD(histogram, value) ((void)0)
+#define STATS_SET(gauge, value) ((void)0)
+#define STATS_PHASE(phase) ((void)0)
+#define STATS_ONLY(statement) ((void)0)
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+
+class SyntaxException : public std::runtime_error {
+public:
+    explicit SyntaxException(const std::string& message)
+        : std::runtime_error(message) {}
+};
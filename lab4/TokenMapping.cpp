@@ -0,0 +1,95 @@
+#include "TokenMapping.h"
+using namespace std;
+
+
+bool TokenMapping::load(const Grammar& grammar, const TokenTable& tokens, const string& mappingFile)
+{
+	terminals.clear();
+	newLineCode = tokens.find("\n").code;
+	for (int i = 0; i < tokens.size(); i++) {
+		int code = tokens.getEntry(i).code;
+		int symbol = grammar.findSymbol(string(tokens.getText(i)));
+		if (code >= static_cast<int>(terminals.size())) {
+			terminals.resize(code + 1, UNMAPPED);
+		}
+		if (symbol >= 0 && grammar.isTerminal(symbol)) {
+			terminals[code] = symbol;
+		}
+	}
+
+	ifstream file(mappingFile);
+	if (!file.is_open()) {
+		cerr << "Could not open " << mappingFile << endl;
+		return false;
+	}
+
+	string line;
+	int lineNum = 0;
+	while (getline(file, line)) {
+		lineNum++;
+		istringstream fields(line);
+		int code;
+		string terminal;
+		if (line.empty() || line[0] == '#') continue;
+
+		if (!(fields >> code >> terminal) || code < 0) {
+			cerr << "Line " << lineNum << " Incorrect mapping format" << endl;
+			return false;
+		}
+		if (code >= static_cast<int>(terminals.size())) {
+			terminals.resize(code + 1, UNMAPPED);
+		}
+
+		if (terminal == "-") {
+			terminals[code] = SKIPPED;
+			continue;
+		}
+		int symbol = grammar.findSymbol(terminal);
+		if (symbol < 0 || !grammar.isTerminal(symbol)) {
+			cerr << "Line " << lineNum << " " << terminal << " is not a terminal of the grammar" << endl;
+			return false;
+		}
+		terminals[code] = symbol;
+	}
+	return true;
+}
+
+TerminalReader::TerminalReader(const ProgramInternalForm& pif, const TokenMapping& mapping)
+	: pif(pif), mapping(mapping), position(0), terminal(-1), line(1)
+{
+	skip();
+}
+
+void TerminalReader::advance()
+{
+	if (position < pif.size()) {
+		position++;
+	}
+	skip();
+}
+
+void TerminalReader::skip()
+{
+	int newLineCode = mapping.getNewLineCode();
+	for (; position < pif.size(); position++) {
+		int code = pif.getCode(position);
+		terminal = mapping.terminalOf(code);
+		if (terminal == TokenMapping::SKIPPED) {
+			if (code == newLineCode) {
+				line++;
+			}
+			continue;
+		}
+		if (terminal == TokenMapping::UNMAPPED) {
+			throw SyntaxException("Line " + to_string(line) + ": " + pif.getText(position) + " has no terminal in the grammar");
+		}
+		return;
+	}
+	terminal = -1;
+}
+
+SyntaxException TerminalReader::unexpected(const string& expected) const
+{
+	string found = position < pif.size() ? pif.getText(position) : "end of program";
+	return SyntaxException("Line " + to_string(line) + ": unexpected " + found + ", expected " + expected);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Grammar.h"
+#include "TokenTable.h"
+#include "ProgramInternalForm.h"
+#include "SyntaxException.cpp"
+
+// the terminal of a grammar that each token code of the scanner stands for
+// a token whose text is the name of a terminal gets that terminal, a mapping file gives the rest
+class TokenMapping {
+public:
+    static constexpr int UNMAPPED = -1;
+    // dropped before parsing, like the spaces and new lines the grammar doesn't mention
+    static constexpr int SKIPPED = -2;
+
+    // each line of the file is "code terminal", or "code -" for a token that is skipped, # starts a comment
+    bool load(const Grammar& grammar, const TokenTable& tokens, const std::string& mappingFile);
+
+    // symbol id of the terminal, UNMAPPED or SKIPPED
+    int terminalOf(int code) const {
+        return code >= 0 && code < static_cast<int>(terminals.size()) ? terminals[code] : UNMAPPED;
+    }
+    // code of the new line token, so the parser can count lines without looking at token text
+    int getNewLineCode() const { return newLineCode; }
+
+private:
+    std::vector<int> terminals;     // by token code
+    int newLineCode = -1;
+};
+
+// the terminals of a PIF one at a time for a parser, with the skipped tokens dropped and the lines counted
+class TerminalReader {
+public:
+    TerminalReader(const ProgramInternalForm& pif, const TokenMapping& mapping);
+
+    // terminal of the current token, -1 at the end of the program
+    int current() const { return terminal; }
+    // throws a SyntaxException when the next token has no terminal
+    void advance();
+
+    int getLine() const { return line; }
+    // "Line L: unexpected <current token>, expected <expected>"
+    SyntaxException unexpected(const std::string& expected) const;
+
+private:
+    const ProgramInternalForm& pif;
+    const TokenMapping& mapping;
+    size_t position;
+    int terminal;
+    int line;
+
+    void skip();
+};
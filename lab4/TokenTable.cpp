@@ -0,0 +1,139 @@
+#include "TokenTable.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+
+const char* categoryName(TokenCategory category)
+{
+	switch (category) {
+	case TokenCategory::Operator:
+		return "operator";
+	case TokenCategory::Separator:
+		return "separator";
+	case TokenCategory::ReservedWord:
+		return "reserved word";
+	default:
+		return "none";
+	}
+}
+
+uint64_t TokenTable::hashText(const char* data, size_t length, uint64_t seed)
+{
+	//fnv-1a, the texts are only a few bytes long
+	uint64_t hash = 0xCBF29CE484222325ull ^ (seed * 0x9E3779B97F4A7C15ull);
+	for (size_t i = 0; i < length; i++) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 0x100000001B3ull;
+	}
+	return hash ^ (hash >> 32);
+}
+
+size_t TokenTable::slotFor(uint64_t hash) const
+{
+	//the bucket picks a displacement, the displacement is mixed into the same hash, so the text is hashed once
+	uint64_t mixed = hash ^ (displacements[(hash >> 32) % displacements.size()] * 0xC2B2AE3D27D4EB4Full);
+	mixed ^= mixed >> 29;
+	mixed *= 0xBF58476D1CE4E5B9ull;
+	mixed ^= mixed >> 32;
+	return mixed % slots.size();
+}
+
+void TokenTable::add(const std::string& text, TokenCategory category, int code)
+{
+	//a text that is already there keeps its first entry, like the map this replaced
+	for (int i = 0; i < size(); i++) {
+		if (getText(i) == text) {
+			return;
+		}
+	}
+	entries.push_back({ static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(text.size()), category, code });
+	arena += text;
+}
+
+bool TokenTable::place(uint64_t tryingSeed)
+{
+	size_t n = entries.size();
+	vector<uint64_t> hashes(n);
+	for (size_t i = 0; i < n; i++) {
+		hashes[i] = hashText(arena.data() + entries[i].offset, entries[i].length, tryingSeed);
+	}
+
+	size_t bucketCount = n / 2 + 1;
+	displacements.assign(bucketCount, 0);
+	slots.assign(n, -1);
+
+	vector<vector<int>> buckets(bucketCount);
+	for (size_t i = 0; i < n; i++) {
+		buckets[(hashes[i] >> 32) % bucketCount].push_back(static_cast<int>(i));
+	}
+
+	//the biggest buckets go first, while most of the slots are still free
+	vector<size_t> order(bucketCount);
+	for (size_t b = 0; b < bucketCount; b++) {
+		order[b] = b;
+	}
+	stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+	vector<size_t> taken;
+	for (size_t b : order) {
+		if (buckets[b].empty()) {
+			break;
+		}
+
+		bool placed = false;
+		for (uint32_t displacement = 0; displacement < (1u << 16) && !placed; displacement++) {
+			displacements[b] = displacement;
+			taken.clear();
+			placed = true;
+			for (int entry : buckets[b]) {
+				size_t slot = slotFor(hashes[entry]);
+				if (slots[slot] != -1 || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+					placed = false;
+					break;
+				}
+				taken.push_back(slot);
+			}
+		}
+		if (!placed) {
+			return false;
+		}
+		for (size_t i = 0; i < taken.size(); i++) {
+			slots[taken[i]] = buckets[b][i];
+		}
+	}
+
+	seed = tryingSeed;
+	return true;
+}
+
+void TokenTable::build()
+{
+	if (entries.empty()) {
+		slots.clear();
+		displacements.assign(1, 0);
+		return;
+	}
+
+	//a bucket with no displacement that fits needs a different hash, which almost never happens
+	for (uint64_t tryingSeed = 0; tryingSeed < 64; tryingSeed++) {
+		if (place(tryingSeed)) {
+			return;
+		}
+	}
+	throw runtime_error("Could not build a perfect hash for the tokens");
+}
+
+TokenTable::Entry TokenTable::find(std::string_view text) const
+{
+	if (slots.empty()) {
+		return {};
+	}
+
+	const Stored& stored = entries[slots[slotFor(hashText(text.data(), text.size(), seed))]];
+	if (stored.length != text.size() || memcmp(arena.data() + stored.offset, text.data(), text.size()) != 0) {
+		return {};
+	}
+	return { stored.category, stored.code };
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+enum class TokenCategory : unsigned char {
+    None,
+    Operator,
+    Separator,
+    ReservedWord
+};
+
+// "operator", "separator", "reserved word", the names token.txt is described with
+const char* categoryName(TokenCategory category);
+
+// the fixed operator / separator / reserved word vocabulary behind a minimal perfect hash
+// the table is built once when the spec is loaded, a lookup is one hash of the text and one memcmp
+class TokenTable {
+public:
+    struct Entry {
+        TokenCategory category = TokenCategory::None;
+        int code = 0;
+    };
+
+    void add(const std::string& text, TokenCategory category, int code);
+    // picks the displacements, has to be called after the last add and before any find
+    void build();
+
+    // category None and code 0 when the text is not a token
+    Entry find(std::string_view text) const;
+    TokenCategory category(std::string_view text) const { return find(text).category; }
+
+    int size() const { return static_cast<int>(entries.size()); }
+    // entries in the order they were added
+    std::string_view getText(int index) const { return std::string_view(arena.data() + entries[index].offset, entries[index].length); }
+    Entry getEntry(int index) const { return { entries[index].category, entries[index].code }; }
+
+private:
+    struct Stored {
+        uint32_t offset;
+        uint32_t length;
+        TokenCategory category;
+        int code;
+    };
+
+    std::string arena;
+    std::vector<Stored> entries;
+
+    // slot i holds the index of an entry, every entry has exactly one slot
+    std::vector<int> slots;
+    std::vector<uint32_t> displacements;
+    uint64_t seed = 0;
+
+    static uint64_t hashText(const char* data, size_t length, uint64_t seed);
+    size_t slotFor(uint64_t hash) const;
+    bool place(uint64_t tryingSeed);
+};
@@ -1,6 +1,9 @@
 #include "Scanner.h"
 #include "FiniteAutomata.h"
 #include "Grammar.h"
+#include "LL1Parser.h"
+#include "LALRParser.h"
+#include "Statistics.h"
 using namespace std;
 
 int main() {
@@ -20,5 +23,56 @@ int main() {
 
     grammar.computeFollow();
     grammar.printFollowSets();
+    cout << endl;
+
+    // the language grammar is not LL(1), g3 is the same language rewritten so it is
+    Grammar language;
+    language.readFromFile("g2.txt");
+    language.computeFirst();
+    LL1Parser(language).printConflicts();
+    cout << endl;
+
+    Grammar ll1;
+    ll1.readFromFile("g3.txt");
+    ll1.computeFirst();
+    LL1Parser parser(ll1);
+    parser.printConflicts();
+
+    Scanner scanner("p1.txt");
+    TokenMapping mapping;
+    try {
+        scanner.scan();
+        if (mapping.load(ll1, scanner.getSpec().getTokens(), "g3-tokens.txt")) {
+            parser.printDerivation(parser.parse(scanner.getPIF(), mapping));
+        }
+    }
+    catch (const exception& e) {
+        cout << e.what() << endl;
+    }
+    cout << endl;
+
+    // g4 keeps the left recursion of g2, an LALR(1) parser takes it as it is
+    Grammar lr;
+    lr.readFromFile("g4.txt");
+    lr.computeFirst();
+    LALRParser lalrParser(lr);
+    lalrParser.printConflicts();
+    lalrParser.printStatistics();
+
+    TokenMapping lrMapping;
+    try {
+        if (lrMapping.load(lr, scanner.getSpec().getTokens(), "g3-tokens.txt")) {
+            lalrParser.printDerivation(lalrParser.parse(scanner.getPIF(), lrMapping));
+        }
+    }
+    catch (const exception& e) {
+        cout << e.what() << endl;
+    }
+
+    // builds with LAB4_STATISTICS defined say where the time of the run went
+    if (Statistics::enabled()) {
+        ofstream statistics("statistics.json");
+        Statistics::writeReport(statistics);
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "LexerSpec.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cctype>
+using namespace std;
+
+// lexgen: writes the lexer of token.txt and the FA-*.in files as constexpr tables
+// it runs in the lab4 directory before lab4 is built: lexgen [--spec token.lex] [output path]
+// with --spec the token classes come from the regular expressions of that file instead of the FA files
+
+static string characterName(char ch)
+{
+	switch (ch) {
+	case '[': return "LeftBracket";
+	case ']': return "RightBracket";
+	case '(': return "LeftParen";
+	case ')': return "RightParen";
+	case '{': return "LeftBrace";
+	case '}': return "RightBrace";
+	case '<': return "Less";
+	case '>': return "Greater";
+	case ':': return "Colon";
+	case ',': return "Comma";
+	case '~': return "Tilde";
+	case ' ': return "Space";
+	case '\n': return "NewLine";
+	case '\t': return "Tab";
+	default: return "Char" + to_string(static_cast<unsigned char>(ch));
+	}
+}
+
+static string enumName(const string& token)
+{
+	bool word = !token.empty();
+	for (char ch : token) {
+		if (!isalnum(static_cast<unsigned char>(ch)) && ch != '_')
+			word = false;
+	}
+
+	//pascal case, so no enumerator can collide with an all caps macro such as TRUE on windows
+	string name;
+	if (word) {
+		name = token;
+		name[0] = static_cast<char>(toupper(static_cast<unsigned char>(name[0])));
+		return name;
+	}
+
+	for (char ch : token)
+		name += characterName(ch);
+	return name;
+}
+
+static string quoted(const string& text)
+{
+	string result = "\"";
+	for (char ch : text) {
+		if (ch == '\n')
+			result += "\\n";
+		else if (ch == '\t')
+			result += "\\t";
+		else if (ch == '"' || ch == '\\')
+			result += string("\\") + ch;
+		else
+			result += ch;
+	}
+	return result + "\"";
+}
+
+static string categoryEnumName(TokenCategory category)
+{
+	switch (category) {
+	case TokenCategory::Operator:
+		return "TokenCategory::Operator";
+	case TokenCategory::Separator:
+		return "TokenCategory::Separator";
+	case TokenCategory::ReservedWord:
+		return "TokenCategory::ReservedWord";
+	default:
+		return "TokenCategory::None";
+	}
+}
+
+template <class T>
+static void writeArray(ostream& out, const string& declaration, const vector<T>& values)
+{
+	out << "    static constexpr " << declaration << " = {";
+	for (size_t i = 0; i < values.size(); i++) {
+		out << (i % 16 == 0 ? "\n        " : " ") << values[i] << (i + 1 < values.size() ? "," : "");
+	}
+	out << "\n    };\n";
+}
+
+int main(int argc, char** argv)
+{
+	string outputPath = "LexerTables.h";
+	string specPath;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if (argument == "--spec" && i + 1 < argc)
+			specPath = argv[++i];
+		else
+			outputPath = argument;
+	}
+
+	unique_ptr<LexerSpec> loaded;
+	try {
+		loaded.reset(specPath.empty() ? new LexerSpec() : new LexerSpec(specPath));
+	}
+	catch (const exception& e) {
+		cerr << "lexgen: " << e.what() << endl;
+		return 1;
+	}
+	const LexerSpec& spec = *loaded;
+	const DFATable& table = spec.getLexer().getTable();
+	if (table.stateCount > 32767 || table.classCount > 255) {
+		cerr << "lexgen: the lexer DFA is too big for the generated table types" << endl;
+		return 1;
+	}
+
+	const TokenTable& tokens = spec.getTokens();
+	int tokenCount = 0;
+	for (int i = 0; i < tokens.size(); i++)
+		tokenCount = max(tokenCount, tokens.getEntry(i).code);
+	vector<string> texts(tokenCount), categories(tokenCount);
+	for (int i = 0; i < tokens.size(); i++) {
+		TokenTable::Entry entry = tokens.getEntry(i);
+		texts[entry.code - 1] = string(tokens.getText(i));
+		categories[entry.code - 1] = categoryEnumName(entry.category);
+	}
+
+	ostringstream out;
+	out << "// generated by lexgen from token.txt and " << (specPath.empty() ? string("the FA-*.in files") : specPath) << ", do not edit\n";
+	out << "#pragma once\n";
+	out << "#include \"TokenTable.h\"\n\n";
+
+	out << "enum class TokenCode : int {\n";
+	for (int code = 1; code <= tokenCount; code++)
+		out << "    " << enumName(texts[code - 1]) << " = " << code << ",\n";
+	out << "    Identifier = " << LexerSpec::IDENTIFIER_CODE << ",\n";
+	out << "    Constant = " << LexerSpec::CONSTANT_CODE << "\n";
+	out << "};\n\n";
+
+	out << "struct LexerTables {\n";
+	out << "    static constexpr int classCount = " << table.classCount << ";\n";
+	out << "    static constexpr int stateCount = " << table.stateCount << ";\n";
+	out << "    static constexpr int initialState = " << table.initialState << ";\n";
+	out << "    static constexpr int tokenCount = " << tokenCount << ";\n\n";
+
+	writeArray(out, "unsigned char charClass[256]", vector<int>(table.charClass.begin(), table.charClass.end()));
+	writeArray(out, "short next[stateCount * classCount]", table.next);
+	writeArray(out, "signed char accept[stateCount]", table.accept);
+
+	vector<int> delimiters;
+	for (int ch = 0; ch < 256; ch++)
+		delimiters.push_back(spec.isDelimiter(static_cast<unsigned char>(ch)) ? 1 : 0);
+	writeArray(out, "bool delimiters[256]", delimiters);
+
+	vector<string> quotedTexts;
+	for (int i = 0; i < tokenCount; i++) {
+		quotedTexts.push_back(quoted(texts[i]));
+	}
+	out << "\n    // text and category of the token with code i + 1\n";
+	writeArray(out, "const char* tokenTexts[tokenCount]", quotedTexts);
+	writeArray(out, "TokenCategory tokenCategories[tokenCount]", categories);
+	out << "};\n";
+
+	//leave the file alone when nothing changed, so lab4 isn't rebuilt for nothing
+	string header = out.str();
+	ifstream existing(outputPath, ios::binary);
+	stringstream current;
+	current << existing.rdbuf();
+	if (existing && current.str() == header)
+		return 0;
+	existing.close();
+
+	ofstream file(outputPath, ios::binary);
+	file << header;
+	cout << "lexgen: wrote " << outputPath << " (" << table.stateCount << " states, " << table.classCount << " classes)" << endl;
+	return file ? 0 : 1;
+}